@@ -0,0 +1,318 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <algorithm>
+#include <ranges>
+#include <type_traits>
+
+namespace bee {
+    /// Zamiana wartości na reprezentację we wskazanej kolejności bajtów (i odwrotnie - operacja jest symetryczna).
+    template<Scalar T>
+    constexpr T to_endian(T const value, std::endian const order) noexcept {
+        static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                      "to_endian: no same-size integer for this type (e.g. long double is not supported)");
+        if constexpr (sizeof(T) == 1)
+            return value;
+        else {
+            if (order == std::endian::native)
+                return value;
+            using U = std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>;
+            return std::bit_cast<T>(std::byteswap(std::bit_cast<U>(value)));
+        }
+    }
+
+    /// Kodowanie zig-zag: liczby ze znakiem o małej wartości bezwzględnej dają małe liczby bez znaku.
+    constexpr u64 zigzag_encode(i64 const value) noexcept {
+        return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+    }
+
+    /// Dekodowanie zig-zag.
+    constexpr i64 zigzag_decode(u64 const value) noexcept {
+        return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1);
+    }
+
+    /// Maksymalna długość zapisu LEB128 liczby 64-bitowej.
+    inline constexpr size_t MaxVarintSize = 10;
+
+    /****************************************************************
+    *                                                               *
+    *                      B y t e W r i t e r                      *
+    *                                                               *
+    ****************************************************************/
+
+    /// Zapis danych binarnych z jawną kolejnością bajtów (bez założeń o wyrównaniu).
+    /// Pracuje na własnym, powiększanym buforze lub na buforze wołającego o stałym rozmiarze.
+    /// Przepełnienie stałego bufora jest zapamiętywane (ok() == false), a dalsze zapisy ignorowane.
+    class ByteWriter final {
+        Vector<u8> buffer_{};   // bufor własny (tryb rosnący)
+        Span<u8> fixed_{};      // bufor wołającego (tryb stały)
+        size_t size_{};
+        bool is_fixed_{};
+        bool overflow_{};
+    public:
+        ByteWriter() = default;
+        /// Bufor własny z zarezerwowanym miejscem na 'capacity' bajtów.
+        explicit ByteWriter(size_t const capacity) : buffer_(capacity) {}
+        /// Zapis do bufora wołającego (bez alokacji).
+        explicit ByteWriter(Span<u8> const buffer) noexcept : fixed_{buffer}, is_fixed_{true} {}
+        ByteWriter(ByteWriter const&) = default;
+        ByteWriter(ByteWriter&&) noexcept = default;
+        ByteWriter& operator=(ByteWriter const&) = default;
+        ByteWriter& operator=(ByteWriter&&) noexcept = default;
+        ~ByteWriter() = default;
+
+        /// Zapis liczby we wskazanej kolejności bajtów.
+        template<Scalar T>
+        ByteWriter& put(T const value, std::endian const order = std::endian::little) noexcept {
+            if (auto const out = reserve(sizeof(T))) {
+                auto const v = to_endian(value, order);
+                std::memcpy(out, &v, sizeof(T));
+            }
+            return *this;
+        }
+
+        template<Scalar T>
+        ByteWriter& put_le(T const value) noexcept { return put(value, std::endian::little); }
+        template<Scalar T>
+        ByteWriter& put_be(T const value) noexcept { return put(value, std::endian::big); }
+
+        /// Zapis wielu liczb naraz. Przy zgodnej kolejności bajtów to jedno memcpy,
+        /// w przeciwnym razie pętla zamiany bajtów, którą kompilator wektoryzuje.
+        template<Scalar T>
+        ByteWriter& put_span(Span<const T> const values, std::endian const order = std::endian::little) noexcept {
+            auto const out = reserve(values.size_bytes());
+            if (!out)
+                return *this;
+            if (sizeof(T) == 1 || order == std::endian::native)
+                std::memcpy(out, values.data(), values.size_bytes());
+            else
+                for (size_t i = 0; i < values.size(); ++i) {
+                    auto const v = to_endian(values[i], order);
+                    std::memcpy(out + i * sizeof(T), &v, sizeof(T));
+                }
+            return *this;
+        }
+
+        /// Zapis wielu liczb z dowolnego ciągłego kontenera (np. Vector, Array).
+        template<std::ranges::contiguous_range R>
+            requires Scalar<std::ranges::range_value_t<R>>
+        ByteWriter& put_span(R const& values, std::endian const order = std::endian::little) noexcept {
+            return put_span(Span<const std::ranges::range_value_t<R>>{values}, order);
+        }
+
+        /// Zapis surowych bajtów.
+        ByteWriter& put_bytes(Span<const u8> const bytes) noexcept {
+            if (auto const out = reserve(bytes.size()); out && !bytes.empty())
+                std::memcpy(out, bytes.data(), bytes.size());
+            return *this;
+        }
+        ByteWriter& put_bytes(StringView const text) noexcept {
+            return put_bytes(Span<const u8>{reinterpret_cast<u8 const*>(text.data()), text.size()});
+        }
+
+        /// Zapis liczby bez znaku w kodowaniu LEB128 (7 bitów na bajt, 1-10 bajtów).
+        ByteWriter& put_varint(u64 value) noexcept {
+            u8 bytes[MaxVarintSize];
+            size_t n = 0;
+            while (value >= 0x80) {
+                bytes[n++] = static_cast<u8>(value | 0x80);
+                value >>= 7;
+            }
+            bytes[n++] = static_cast<u8>(value);
+            return put_bytes(Span<const u8>{bytes, n});
+        }
+
+        /// Zapis liczby ze znakiem: zig-zag, a następnie LEB128.
+        ByteWriter& put_zigzag(i64 const value) noexcept {
+            return put_varint(zigzag_encode(value));
+        }
+
+        /// Zapisane dane.
+        [[nodiscard]] Span<const u8> data() const noexcept {
+            return is_fixed_ ? fixed_.first(size_) : Span<const u8>{buffer_.data(), size_};
+        }
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        /// Czy wszystkie zapisy zmieściły się w buforze?
+        [[nodiscard]] bool ok() const noexcept { return !overflow_; }
+
+        /// Odebranie własnego bufora (tryb rosnący) - writer zostaje pusty.
+        Vector<u8> take() noexcept {
+            buffer_.resize(size_);
+            size_ = 0;
+            return std::move(buffer_);
+        }
+
+        /// Usunięcie zapisanych danych (bufor zostaje do ponownego użycia).
+        void clear() noexcept {
+            size_ = 0;
+            overflow_ = false;
+        }
+
+    private:
+        /// Miejsce na 'n' kolejnych bajtów lub nullptr, gdy stały bufor jest pełny.
+        u8* reserve(size_t const n) noexcept {
+            if (overflow_)
+                return nullptr;
+            if (is_fixed_) {
+                if (n > fixed_.size() - size_) {
+                    overflow_ = true;
+                    return nullptr;
+                }
+            } else if (n > buffer_.size() - size_)
+                buffer_.resize(std::max({buffer_.size() * 2, size_ + n, size_t{64}}));
+            auto const out = (is_fixed_ ? fixed_.data() : buffer_.data()) + size_;
+            size_ += n;
+            return out;
+        }
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                      B y t e R e a d e r                      *
+    *                                                               *
+    ****************************************************************/
+
+    /// Odczyt danych binarnych z jawną kolejnością bajtów (bez założeń o wyrównaniu).
+    /// Odczyt poza końcem danych zwraca pusty Option i jest zapamiętywany (ok() == false).
+    class ByteReader final {
+        Span<const u8> data_{};
+        size_t position_{};
+        bool failed_{};
+    public:
+        ByteReader() = default;
+        explicit ByteReader(Span<const u8> const data) noexcept : data_{data} {}
+        explicit ByteReader(Span<const char> const data) noexcept
+            : data_{reinterpret_cast<u8 const*>(data.data()), data.size()}
+        {}
+
+        /// Odczyt liczby zapisanej we wskazanej kolejności bajtów.
+        template<Scalar T>
+        Option<T> get(std::endian const order = std::endian::little) noexcept {
+            auto const in = take(sizeof(T));
+            if (!in)
+                return {};
+            T value;
+            std::memcpy(&value, in, sizeof(T));
+            return to_endian(value, order);
+        }
+
+        template<Scalar T>
+        Option<T> get_le() noexcept { return get<T>(std::endian::little); }
+        template<Scalar T>
+        Option<T> get_be() noexcept { return get<T>(std::endian::big); }
+
+        /// Odczyt wielu liczb naraz (odpowiednik ByteWriter::put_span).
+        /// \return FALSE, jeśli danych jest za mało (nic nie zostaje odczytane).
+        template<Scalar T>
+        bool get_span(Span<T> const values, std::endian const order = std::endian::little) noexcept {
+            if (values.empty())
+                return true;
+            auto const in = take(values.size_bytes());
+            if (!in)
+                return false;
+            std::memcpy(values.data(), in, values.size_bytes());
+            if (sizeof(T) > 1 && order != std::endian::native)
+                for (auto& v : values)
+                    v = to_endian(v, order);
+            return true;
+        }
+
+        /// Odczyt wielu liczb do dowolnego ciągłego kontenera (np. Vector, Array).
+        template<std::ranges::contiguous_range R>
+            requires Scalar<std::ranges::range_value_t<R>>
+                && std::is_constructible_v<Span<std::ranges::range_value_t<R>>, R&>
+        bool get_span(R& values, std::endian const order = std::endian::little) noexcept {
+            return get_span(Span<std::ranges::range_value_t<R>>{values}, order);
+        }
+
+        /// Odczyt 'n' surowych bajtów (widok na dane źródłowe).
+        Option<Span<const u8>> get_bytes(size_t const n) noexcept {
+            if (n == 0)
+                return Span<const u8>{};
+            auto const in = take(n);
+            if (!in)
+                return {};
+            return Span<const u8>{in, n};
+        }
+
+        /// Odczyt liczby w kodowaniu LEB128. Zapis dłuższy niż 10 bajtów, przekraczający 64 bity
+        /// lub nieminimalny (zakończony zerowym bajtem, np. 80 00) jest błędem.
+        Option<u64> get_varint() noexcept {
+            // Pozycję przesuwamy dopiero po poprawnym odczycie (jak pozostałe funkcje get_*).
+            u64 value = 0;
+            for (size_t i = 0; i < MaxVarintSize && position_ + i < data_.size(); ++i) {
+                auto const byte = data_[position_ + i];
+                if (i == MaxVarintSize - 1 && byte > 1)
+                    break;
+                if (i > 0 && byte == 0)
+                    break;
+                value |= static_cast<u64>(byte & 0x7f) << (7 * i);
+                if (!(byte & 0x80)) {
+                    position_ += i + 1;
+                    return value;
+                }
+            }
+            failed_ = true;
+            return {};
+        }
+
+        /// Odczyt liczby ze znakiem zapisanej przez ByteWriter::put_zigzag.
+        Option<i64> get_zigzag() noexcept {
+            if (auto const value = get_varint())
+                return zigzag_decode(*value);
+            return {};
+        }
+
+        /// Pominięcie 'n' bajtów.
+        bool skip(size_t const n) noexcept {
+            return n == 0 || take(n) != nullptr;
+        }
+
+        [[nodiscard]] size_t position() const noexcept { return position_; }
+        [[nodiscard]] size_t remaining() const noexcept { return data_.size() - position_; }
+        /// Czy wszystkie odczyty się powiodły?
+        [[nodiscard]] bool ok() const noexcept { return !failed_; }
+
+    private:
+        /// Wskaźnik na 'n' kolejnych bajtów lub nullptr, gdy danych jest za mało.
+        u8 const* take(size_t const n) noexcept {
+            if (n > data_.size() - position_) {
+                failed_ = true;
+                return nullptr;
+            }
+            auto const in = data_.data() + position_;
+            position_ += n;
+            return in;
+        }
+    };
+}
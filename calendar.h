@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "civil.h"
+#include "datime.h"
+
+namespace bee {
+    /****************************************************************
+    *                                                               *
+    *                       c a l e n d a r                         *
+    *                                                               *
+    ****************************************************************/
+
+    // Kubełkowanie kalendarzowe wielu chwil naraz (sekundy UTC od początku epoki).
+    // Każdy kernel działa w dwóch krokach na porcjach danych: najpierw zamiana na czas lokalny
+    // przez tablicę przesunięć strefy (TimeZone), potem czysta arytmetyka na liczbach (civil.h),
+    // którą kompilator może wektoryzować. Zmiany czasu (DST) obsługuje tablica przesunięć.
+    // Bufor wynikowy musi mieć co najmniej tyle elementów co dane (nadmiarowe są pomijane).
+
+    namespace detail {
+        /// Liczba chwil przetwarzanych w jednej porcji.
+        inline constexpr size_t CalendarChunk = 512;
+
+        /// Zamiana chwil UTC na czas lokalny strefy bieżącej. Zapamiętuje ostatni przedział
+        /// tablicy przesunięć, więc dla danych uporządkowanych (lub skupionych w czasie)
+        /// wyszukiwanie binarne wykonywane jest tylko przy zmianie przedziału.
+        class LocalCursor {
+            TimeZone::Table const& table_ = TimeZone::table();
+            i64 begin_{1};      // pusty przedział na start
+            i64 end_{0};
+            i64 offset_{};
+        public:
+            [[nodiscard]] i64 operator()(i64 const t) noexcept {
+                if (t >= begin_ && t < end_) [[likely]]
+                    return t + offset_;
+                if (t < table_.first || t >= table_.last)
+                    return TimeZone::to_local(table_.zone, date::sys_seconds{Seconds{t}}).time_since_epoch().count();
+                auto const i = static_cast<size_t>(std::ranges::upper_bound(table_.utc, t) - table_.utc.begin()) - 1;
+                begin_ = table_.utc[i];
+                end_ = (i + 1 < table_.utc.size()) ? table_.utc[i + 1] : table_.last;
+                offset_ = table_.offset[i];
+                return t + offset_;
+            }
+        };
+
+        /// Wywołanie 'fn(local, out, n)' dla kolejnych porcji czasu lokalnego.
+        template<typename T, typename Fn>
+        void for_local_chunks(Span<const i64> const utc, Span<T> const out, Fn&& fn) noexcept {
+            auto const n = std::min(utc.size(), out.size());
+            LocalCursor to_local{};
+            i64 local[CalendarChunk];
+            for (size_t i = 0; i < n; i += CalendarChunk) {
+                auto const count = std::min(CalendarChunk, n - i);
+                for (size_t j = 0; j < count; ++j)
+                    local[j] = to_local(utc[i + j]);
+                fn(local, out.data() + i, count);
+            }
+        }
+
+        /// Numer dnia (od początku epoki) dla lokalnych sekund.
+        constexpr i64 day_of(i64 const local) noexcept {
+            return floor_div(local, SecondsPerDay);
+        }
+    }
+
+    /// Klucze dni: numer dnia lokalnego od początku epoki (1970-01-01 to dzień 0).
+    inline void day_keys(Span<const i64> const utc, Span<i64> const out) noexcept {
+        detail::for_local_chunks(utc, out, [](i64 const* const local, i64* const keys, size_t const n) {
+            for (size_t i = 0; i < n; ++i)
+                keys[i] = detail::day_of(local[i]);
+        });
+    }
+
+    /// Klucze godzin: numer godziny lokalnej od początku epoki.
+    /// W godzinie powtórzonej przy zmianie czasu obie godziny dają ten sam klucz.
+    inline void hour_keys(Span<const i64> const utc, Span<i64> const out) noexcept {
+        detail::for_local_chunks(utc, out, [](i64 const* const local, i64* const keys, size_t const n) {
+            for (size_t i = 0; i < n; ++i)
+                keys[i] = floor_div(local[i], 3600);
+        });
+    }
+
+    /// Klucze tygodni: numer dnia (od początku epoki) poniedziałku tygodnia ISO.
+    inline void week_keys(Span<const i64> const utc, Span<i64> const out) noexcept {
+        detail::for_local_chunks(utc, out, [](i64 const* const local, i64* const keys, size_t const n) {
+            for (size_t i = 0; i < n; ++i) {
+                auto const day = detail::day_of(local[i]);
+                keys[i] = day - static_cast<i64>(iso_weekday_from_days(day)) + 1;
+            }
+        });
+    }
+
+    /// Klucze miesięcy: rok * 12 + (miesiąc - 1).
+    inline void month_keys(Span<const i64> const utc, Span<i32> const out) noexcept {
+        detail::for_local_chunks(utc, out, [](i64 const* const local, i32* const keys, size_t const n) {
+            for (size_t i = 0; i < n; ++i) {
+                auto const civil = civil_from_days(detail::day_of(local[i]));
+                keys[i] = civil.y * 12 + static_cast<i32>(civil.m) - 1;
+            }
+        });
+    }
+
+    /// Numery dni tygodnia (czas lokalny): 1-poniedziałek, ... , 7-niedziela.
+    inline void week_days(Span<const i64> const utc, Span<u8> const out) noexcept {
+        detail::for_local_chunks(utc, out, [](i64 const* const local, u8* const days, size_t const n) {
+            for (size_t i = 0; i < n; ++i)
+                days[i] = static_cast<u8>(iso_weekday_from_days(detail::day_of(local[i])));
+        });
+    }
+
+    /// Granice dni lokalnych zawierających chwile (sekundy UTC).
+    /// Początek to północ, koniec to 23:59:59 (jak Datime::beginning_day i Datime::end_day);
+    /// w dniach zmiany czasu dzień ma 23 lub 25 godzin.
+    /// \param utc Chwile,
+    /// \param begins Bufor na początki dni,
+    /// \param ends Bufor na końce dni.
+    inline void day_bounds(Span<const i64> const utc, Span<i64> const begins, Span<i64> const ends) noexcept {
+        auto const n = std::min({utc.size(), begins.size(), ends.size()});
+        day_keys(utc.first(n), begins.first(n));
+        // Kolejne chwile zwykle należą do tego samego dnia - granice liczymy raz na dzień.
+        auto const zone = TimeZone::zone();
+        auto const start_of = [zone](i64 const day) {
+            auto const local = date::local_seconds{Seconds{day * SecondsPerDay}};
+            return TimeZone::to_sys(zone, local).time_since_epoch().count();
+        };
+        i64 day = 0, begin = 0, end = -1;
+        for (size_t i = 0; i < n; ++i) {
+            if (begins[i] != day || end < begin) {
+                day = begins[i];
+                begin = start_of(day);
+                end = start_of(day + 1) - 1;
+            }
+            begins[i] = begin;
+            ends[i] = end;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+
+namespace bee {
+    /****************************************************************
+    *                                                               *
+    *                          c i v i l                            *
+    *                                                               *
+    ****************************************************************/
+
+    // Arytmetyka kalendarza gregoriańskiego na liczbach (algorytmy H. Hinnanta):
+    // bez tablic i prawie bez rozgałęzień, więc pętle po wielu datach kompilator wektoryzuje.
+
+    inline constexpr i64 SecondsPerDay = 86'400;
+
+    /// Data kalendarzowa.
+    struct CivilDate {
+        i32 y{};
+        u32 m{};
+        u32 d{};
+        constexpr bool operator==(CivilDate const&) const = default;
+    };
+
+    /// Dzielenie z zaokrągleniem w dół (także dla liczb ujemnych).
+    constexpr i64 floor_div(i64 const a, i64 const b) noexcept {
+        return a / b - ((a % b != 0) & ((a < 0) != (b < 0)));
+    }
+
+    /// Czy rok jest przestępny?
+    constexpr bool is_leap_year(i32 const y) noexcept {
+        return (y % 4 == 0) && ((y % 100 != 0) || (y % 400 == 0));
+    }
+
+    /// Liczba dni w miesiącu.
+    constexpr u32 days_in_month(i32 const y, u32 const m) noexcept {
+        if (m == 2)
+            return is_leap_year(y) ? 29 : 28;
+        return 30 + ((m + (m >> 3)) & 1);
+    }
+
+    /// Numer dnia od początku epoki (1970-01-01 to dzień 0).
+    constexpr i64 days_from_civil(i32 y, u32 const m, u32 const d) noexcept {
+        y -= (m <= 2);
+        auto const era = static_cast<i64>(y >= 0 ? y : y - 399) / 400;
+        auto const yoe = static_cast<u32>(y - era * 400);
+        auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146'097 + static_cast<i64>(doe) - 719'468;
+    }
+
+    /// Data kalendarzowa dnia o wskazanym numerze (1970-01-01 to dzień 0).
+    constexpr CivilDate civil_from_days(i64 z) noexcept {
+        z += 719'468;
+        auto const era = (z >= 0 ? z : z - 146'096) / 146'097;
+        auto const doe = static_cast<u32>(z - era * 146'097);
+        auto const yoe = (doe - doe / 1460 + doe / 36'524 - doe / 146'096) / 365;
+        auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        auto const mp = (5 * doy + 2) / 153;
+        auto const d = doy - (153 * mp + 2) / 5 + 1;
+        auto const m = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<i32>(static_cast<i64>(yoe) + era * 400 + (m <= 2)), m, d};
+    }
+
+    /// Dzień tygodnia dnia o wskazanym numerze: 1-poniedziałek, ... , 7-niedziela (ISO).
+    constexpr u32 iso_weekday_from_days(i64 const z) noexcept {
+        // 1970-01-01 był czwartkiem.
+        auto const wd = (z % 7 + 7 + 3) % 7;
+        return static_cast<u32>(wd + 1);
+    }
+}
@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "datime.h"
+#include <chrono>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace bee {
+    /****************************************************************
+    *                                                               *
+    *                   M o n o t o n i c C l o c k                 *
+    *                                                               *
+    ****************************************************************/
+
+    /// Tani zegar monotoniczny do pomiarów czasu w gorących ścieżkach.
+    /// Na x86-64 z niezmiennym licznikiem TSC odczyt to jedna instrukcja rdtsc,
+    /// w pozostałych przypadkach std::chrono::steady_clock.
+    /// Zegar kalibrowany jest raz względem steady_clock i zegara systemowego.
+    /// To zegar do pomiaru odcinków czasu, nie czasu ściennego: błąd kalibracji i korekty NTP
+    /// sprawiają, że now() z czasem oddala się od zegara systemowego (1e-5 to ok. 0,9 s na dobę).
+    /// Chwile biznesowe (zapisywane, porównywane między procesami) bierzemy z NanoTimestamp::now().
+    class MonotonicClock final {
+    public:
+        /// Czas trwania kalibracji licznika TSC.
+        static constexpr auto CalibrationTime = std::chrono::milliseconds{10};
+
+        /// Parametry zegara wyznaczone przy kalibracji.
+        struct Calibration {
+            bool tsc{};             // czy używamy licznika TSC
+            u64 ticks{};            // odczyt licznika w chwili kalibracji
+            i64 wall{};             // czas systemowy (ns od początku epoki) w chwili kalibracji
+            double ns_per_tick{1.0};
+        };
+
+        /// Kalibracja zegara przed pierwszym użyciem (wywoływana przy starcie programu,
+        /// aby koszt nie obciążał pierwszego pomiaru).
+        static void warm_up() {
+            (void)calibration();
+        }
+
+        /// Bieżący odczyt licznika (jednostki zależne od platformy, patrz to_nanoseconds).
+        static u64 ticks() noexcept {
+#if defined(__x86_64__)
+            if (calibration().tsc)
+                return __rdtsc();
+#endif
+            return steady_ticks();
+        }
+
+        /// Zamiana różnicy odczytów licznika na nanosekundy.
+        static i64 to_nanoseconds(u64 const from, u64 const to) noexcept {
+            auto const delta = static_cast<i64>(to - from);
+            return static_cast<i64>(static_cast<double>(delta) * calibration().ns_per_tick);
+        }
+
+        /// Nanosekundy, jakie upłynęły od wskazanego odczytu licznika.
+        static i64 elapsed_ns(u64 const from) noexcept {
+            return to_nanoseconds(from, ticks());
+        }
+
+        /// Bieżąca chwila monotoniczna: czas systemowy z chwili kalibracji plus czas zmierzony licznikiem.
+        /// Nadaje się do znaczników w pomiarach (nie cofa się), ale nie jako czas ścienny
+        /// - w długo działającym procesie rozjeżdża się z zegarem systemowym (patrz opis klasy).
+        static NanoTimestamp now() noexcept {
+            auto const& c = calibration();
+            return NanoTimestamp{c.wall + to_nanoseconds(c.ticks, ticks())};
+        }
+
+        /// Parametry kalibracji (wyznaczane raz na proces).
+        static Calibration const& calibration() noexcept {
+            static Calibration const c = calibrate();
+            return c;
+        }
+
+    private:
+        static u64 steady_ticks() noexcept {
+            auto const now = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
+
+        /// Czy procesor ma niezmienny licznik TSC (stała częstotliwość, niezależna od stanów energetycznych)?
+        static bool has_invariant_tsc() noexcept {
+#if defined(__x86_64__)
+            unsigned eax{}, ebx{}, ecx{}, edx{};
+            if (__get_cpuid(0x8000'0007, &eax, &ebx, &ecx, &edx))
+                return (edx & (1u << 8)) != 0;
+#endif
+            return false;
+        }
+
+        static Calibration calibrate() noexcept {
+            using namespace std::chrono;
+            Calibration c{};
+#if defined(__x86_64__)
+            if (has_invariant_tsc()) {
+                // Liczymy takty TSC w znanym odcinku czasu steady_clock.
+                auto const start = steady_ticks();
+                auto const tsc = __rdtsc();
+                c.wall = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+                u64 now{};
+                do {
+                    now = steady_ticks();
+                } while (now - start < static_cast<u64>(duration_cast<nanoseconds>(CalibrationTime).count()));
+                auto const ticks = __rdtsc() - tsc;
+                if (ticks > 0) {
+                    c.tsc = true;
+                    c.ns_per_tick = static_cast<double>(now - start) / static_cast<double>(ticks);
+                    c.ticks = tsc;
+                    return c;
+                }
+            }
+#endif
+            c.ticks = steady_ticks();
+            c.wall = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+            return c;
+        }
+    };
+
+    /// Pomiar czasu wykonania (np. opóźnień w gorących ścieżkach) przez MonotonicClock.
+    class Stopwatch final {
+        u64 start_ = MonotonicClock::ticks();
+    public:
+        /// Rozpoczęcie pomiaru od nowa.
+        void restart() noexcept {
+            start_ = MonotonicClock::ticks();
+        }
+        /// Czas od rozpoczęcia pomiaru.
+        [[nodiscard]] i64 nanoseconds() const noexcept {
+            return MonotonicClock::elapsed_ns(start_);
+        }
+        [[nodiscard]] i64 microseconds() const noexcept {
+            return nanoseconds() / 1'000;
+        }
+        [[nodiscard]] i64 milliseconds() const noexcept {
+            return nanoseconds() / 1'000'000;
+        }
+    };
+}
@@ -0,0 +1,218 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "csv.h"
+#include "shared.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace bee {
+    namespace {
+        /// Rozmiar porcji odczytywanej z pliku.
+        constexpr size_t FileChunkSize = 256 * 1024;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                      C s v R e a d e r                        *
+    *                                                               *
+    ****************************************************************/
+
+    CsvReader::CsvReader(RowSink sink, CsvOptions const& options) noexcept
+        : sink_{std::move(sink)}, options_{options}
+    {}
+
+    void CsvReader::write(Span<const char> const chunk) noexcept {
+        auto const delimiter = options_.delimiter;
+        auto const quote = options_.quote;
+        auto const data = chunk.data();
+        auto const size = chunk.size();
+
+        for (size_t i = 0; i < size; ) {
+            auto const c = data[i];
+            switch (state_) {
+                case State::FieldStart:
+                    ++i;
+                    if (c == delimiter)
+                        end_field();
+                    else if (c == '\n') {
+                        end_field();
+                        end_row();
+                    }
+                    else if (c == quote) {
+                        quoted_ = true;
+                        state_ = State::Quoted;
+                    }
+                    // Początkowe białe znaki i tak zostałyby obcięte.
+                    else if (is_not_space(c)) {
+                        buffer_.push_back(c);
+                        state_ = State::Unquoted;
+                    }
+                    else
+                        pending_ = true;
+                    break;
+                case State::Unquoted: {
+                    // Cudzysłów wewnątrz pola bez cudzysłowu jest zwykłym znakiem.
+                    auto j = i;
+                    while (j < size && data[j] != delimiter && data[j] != '\n')
+                        ++j;
+                    buffer_.append(data + i, j - i);
+                    i = j;
+                    if (i < size) {
+                        end_field();
+                        if (data[i++] == '\n')
+                            end_row();
+                    }
+                    break;
+                }
+                case State::Quoted: {
+                    auto const rest = StringView{data + i, size - i};
+                    auto const pos = rest.find(quote);
+                    auto const n = (pos == StringView::npos) ? rest.size() : pos;
+                    buffer_.append(data + i, n);
+                    i += n;
+                    if (i < size) {
+                        ++i;
+                        state_ = State::QuoteSeen;
+                    }
+                    break;
+                }
+                case State::QuoteSeen:
+                    ++i;
+                    if (c == quote) {
+                        // Podwojony cudzysłów to znak cudzysłowu.
+                        buffer_.push_back(c);
+                        state_ = State::Quoted;
+                    }
+                    else if (c == delimiter)
+                        end_field();
+                    else if (c == '\n') {
+                        end_field();
+                        end_row();
+                    }
+                    // Znaki za zamykającym cudzysłowem: białe pomijamy, pozostałe dołączamy do pola.
+                    else if (is_not_space(c))
+                        buffer_.push_back(c);
+                    break;
+            }
+        }
+    }
+
+    Result<size_t, Error> CsvReader::finish() noexcept {
+        if (state_ == State::Quoted)
+            return Failure(Error(EINVAL, "unterminated quoted field"));
+        if (state_ != State::FieldStart || !fields_.empty() || pending_) {
+            end_field();
+            end_row();
+        }
+        return rows_;
+    }
+
+    void CsvReader::reset() noexcept {
+        buffer_.clear();
+        fields_.clear();
+        field_begin_ = 0;
+        rows_ = 0;
+        pending_ = false;
+        state_ = State::FieldStart;
+        quoted_ = false;
+    }
+
+    void CsvReader::end_field() noexcept {
+        auto begin = field_begin_;
+        auto end = buffer_.size();
+        if (!quoted_) {
+            // Początkowe białe znaki nie trafiają do bufora, obcinamy tylko końcowe.
+            while (end > begin && is_space(buffer_[end - 1]))
+                --end;
+            buffer_.resize(end);
+        }
+        if (quoted_ || end > begin || options_.accept_empty)
+            fields_.emplace_back(begin, end);
+        field_begin_ = buffer_.size();
+        state_ = State::FieldStart;
+        quoted_ = false;
+    }
+
+    void CsvReader::end_row() noexcept {
+        if (!fields_.empty()) {
+            // Widoki tworzymy dopiero teraz - bufor mógł być realokowany w trakcie wiersza.
+            views_.clear();
+            for (auto const& [begin, end] : fields_)
+                views_.emplace_back(buffer_.data() + begin, end - begin);
+            ++rows_;
+            if (sink_)
+                sink_(views_);
+        }
+        buffer_.clear();
+        fields_.clear();
+        field_begin_ = 0;
+        pending_ = false;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                       r e a d _ c s v                         *
+    *                                                               *
+    ****************************************************************/
+
+    Result<size_t, Error> read_csv(Span<const char> const data, CsvReader::RowSink sink, CsvOptions const& options) noexcept {
+        CsvReader reader{std::move(sink), options};
+        reader.write(data);
+        return reader.finish();
+    }
+
+    Result<size_t, Error> read_csv_file(std::filesystem::path const& path, CsvReader::RowSink sink, CsvOptions const& options) noexcept {
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            auto const code = errno;
+            return Failure(Error(code, std::strerror(code), path.string()));
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        CsvReader reader{std::move(sink), options};
+        Vector<char> chunk(FileChunkSize);
+        for (;;) {
+            auto const n = ::read(fd, chunk.data(), chunk.size());
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                auto const code = errno;
+                ::close(fd);
+                return Failure(Error(code, std::strerror(code), path.string()));
+            }
+            if (n == 0)
+                break;
+            reader.write(Span<const char>{chunk.data(), static_cast<size_t>(n)});
+        }
+        ::close(fd);
+        return reader.finish();
+    }
+}
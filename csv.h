@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "error.h"
+#include <functional>
+#include <filesystem>
+
+namespace bee {
+    /// Parametry odczytu CSV.
+    struct CsvOptions {
+        char delimiter{','};    // znak rozdzielający pola
+        char quote{'"'};        // znak otwierający i zamykający pole w cudzysłowie
+        bool accept_empty{};    // czy puste pola też zachować (jak w split)?
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                      C s v R e a d e r                        *
+    *                                                               *
+    ****************************************************************/
+
+    /// Strumieniowy czytnik CSV (RFC 4180): pola w cudzysłowie, podwojony cudzysłów
+    /// jako znak cudzysłowu, znaki nowej linii wewnątrz pól. Dane przyjmowane są porcjami
+    /// dowolnej wielkości (wiersz może być podzielony pomiędzy porcje).
+    /// Pola obcinane są z białych znaków, a puste pomijane (chyba że accept_empty) - tak jak w split.
+    /// Zawartość pola w cudzysłowie nie jest obcinana i takie pole nigdy nie jest pomijane.
+    /// Wiersze bez żadnego pola (np. puste linie) nie są przekazywane.
+    class CsvReader final {
+    public:
+        /// Odbiorca wierszy. Widoki wskazują na wewnętrzny bufor i są ważne tylko w trakcie wywołania.
+        using RowSink = std::function<void(Span<const StringView>)>;
+
+    private:
+        enum class State : u8 { FieldStart, Unquoted, Quoted, QuoteSeen };
+
+        RowSink sink_;
+        CsvOptions options_;
+        String buffer_{};                       // znaki pól bieżącego wiersza
+        Vector<Pair<size_t, size_t>> fields_{}; // granice pól bieżącego wiersza w buforze
+        Vector<StringView> views_{};            // widoki przekazywane odbiorcy
+        size_t field_begin_{};
+        size_t rows_{};
+        State state_{State::FieldStart};
+        bool quoted_{};
+        bool pending_{};    // pominięte białe znaki na początku niezakończonego wiersza
+    public:
+        explicit CsvReader(RowSink sink, CsvOptions const& options = {}) noexcept;
+        CsvReader(CsvReader&&) noexcept = default;
+        CsvReader& operator=(CsvReader&&) noexcept = default;
+        CsvReader(CsvReader const&) = delete;
+        CsvReader& operator=(CsvReader const&) = delete;
+        ~CsvReader() = default;
+
+        /// Przetworzenie kolejnej porcji danych. Kompletne wiersze przekazywane są do odbiorcy.
+        void write(Span<const char> chunk) noexcept;
+
+        /// Zakończenie danych - przekazanie ostatniego (niezakończonego znakiem '\n') wiersza.
+        /// \return Liczba przekazanych wierszy lub błąd (niezamknięty cudzysłów).
+        Result<size_t, Error> finish() noexcept;
+
+        /// Przygotowanie czytnika do nowych danych (bufory zostają zachowane).
+        void reset() noexcept;
+
+        /// Liczba przekazanych do tej pory wierszy.
+        [[nodiscard]] size_t rows() const noexcept {
+            return rows_;
+        }
+
+    private:
+        void end_field() noexcept;
+        void end_row() noexcept;
+    };
+
+    /// Odczyt CSV z bufora w pamięci (np. zmapowanego pliku).
+    /// \return Liczba przekazanych wierszy lub błąd.
+    Result<size_t, Error> read_csv(Span<const char> data, CsvReader::RowSink sink, CsvOptions const& options = {}) noexcept;
+
+    /// Odczyt CSV z pliku porcjami (cały plik nie jest wczytywany do pamięci).
+    /// \return Liczba przekazanych wierszy lub błąd.
+    Result<size_t, Error> read_csv_file(std::filesystem::path const& path, CsvReader::RowSink sink, CsvOptions const& options = {}) noexcept;
+}
@@ -28,8 +28,15 @@
 /*------- include files:
 -------------------------------------------------------------------*/
 #include "types.h"
+#include "error.h"
+#include "civil.h"
+#include "parse.h"
 #include <date/date.h>
 #include <date/tz.h>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <type_traits>
 
 namespace bee {
     using zoned_time_t = date::zoned_time<std::chrono::seconds>;
@@ -37,36 +44,312 @@ namespace bee {
     using Seconds = std::chrono::seconds;
     using Days = std::chrono::days;
 
+    /****************************************************************
+    *                                                               *
+    *                       T i m e Z o n e                         *
+    *                                                               *
+    ****************************************************************/
+
+    /// Strefa czasowa współdzielona przez wszystkie obiekty Datime.
+    /// Strefa wyszukiwana jest w bazie tz raz na proces (a nie przy każdym obiekcie),
+    /// a dla niej budowana jest tablica zmian przesunięcia względem UTC - zamiana
+    /// czasu UTC na lokalny (i odwrotnie) to wyszukiwanie binarne zamiast wyznaczania reguł strefy.
+    class TimeZone final {
+    public:
+        static constexpr auto DefaultName = "Europe/Warsaw";
+        /// Domyślny zakres lat, dla których budowana jest tablica przesunięć.
+        static constexpr int FirstYear = 1900;
+        static constexpr int LastYear = 2200;
+
+        /// Tablica przesunięć strefy: przedział 'i' zaczyna się w chwili utc[i] (czas lokalny local[i])
+        /// i obowiązuje w nim przesunięcie offset[i] (w sekundach).
+        struct Table {
+            date::time_zone const* zone{};
+            Vector<i64> utc{};
+            Vector<i64> local{};
+            Vector<i32> offset{};
+            i64 first{};    // początek zakresu tablicy (UTC)
+            i64 last{};     // koniec zakresu tablicy (UTC)
+
+            /// Przesunięcie obowiązujące w chwili 't' (sekundy UTC, w zakresie tablicy).
+            [[nodiscard]] i64 offset_at(i64 const t) const noexcept {
+                auto const it = std::ranges::upper_bound(utc, t);
+                return offset[static_cast<size_t>(it - utc.begin()) - 1];
+            }
+
+            /// Chwila UTC dla czasu lokalnego 't'. Czas niejednoznaczny (zmiana na czas zimowy)
+            /// daje wcześniejszą z chwil, czas nieistniejący (zmiana na letni) przesuwany jest o lukę.
+            [[nodiscard]] i64 to_utc(i64 const t) const noexcept {
+                auto i = static_cast<size_t>(std::ranges::upper_bound(local, t) - local.begin());
+                i = (i == 0) ? 0 : i - 1;
+                if (i > 0 && t - offset[i - 1] < utc[i])
+                    --i;
+                return t - offset[i];
+            }
+        };
+
+        /// Strefa bieżąca (przy pierwszym użyciu domyślna, DefaultName).
+        static date::time_zone const* zone() {
+            return table().zone;
+        }
+
+        /// Tablica przesunięć strefy bieżącej.
+        static Table const& table() {
+            if (auto const current = current_.load(std::memory_order_acquire))
+                return *current;
+            std::call_once(default_once_, [] {
+                // Strefa ustawiona w międzyczasie przez warm_up ma pierwszeństwo przed domyślną.
+                Table const* expected = nullptr;
+                auto const table = build(date::locate_zone(DefaultName), FirstYear, LastYear);
+                if (!current_.compare_exchange_strong(expected, table, std::memory_order_acq_rel, std::memory_order_acquire))
+                    delete table;
+            });
+            return *current_.load(std::memory_order_acquire);
+        }
+
+        /// Wczytanie bazy tz i zbudowanie tablicy przesunięć przed pierwszym użyciem
+        /// (wywoływane przy starcie programu, aby koszt nie obciążał pierwszych obiektów).
+        /// Może też zmienić strefę używaną przez nowo tworzone obiekty Datime.
+        /// \param name Nazwa strefy w bazie tz,
+        /// \param first_year, last_year Zakres lat tablicy (poza nim używane są reguły strefy).
+        /// \return Sukces lub błąd (np. nieznana strefa).
+        static Result<Unit, Error> warm_up(StringView const name = DefaultName, int const first_year = FirstYear, int const last_year = LastYear) noexcept {
+            if (first_year > last_year)
+                return Failure(Error(-1, "invalid year range", String{name}));
+            try {
+                auto const zone = date::locate_zone(name);
+                // Poprzednia tablica nie jest zwalniana - mogą z niej jeszcze korzystać inne wątki.
+                current_.store(build(zone, first_year, last_year), std::memory_order_release);
+                return Success;
+            } catch (std::exception const& e) {
+                return Failure(Error(-1, e.what(), String{name}));
+            }
+        }
+
+        /// Zamiana chwili UTC na czas lokalny strefy.
+        static date::local_seconds to_local(date::time_zone const* const zone, date::sys_seconds const tp) {
+            auto const& t = table();
+            auto const s = tp.time_since_epoch().count();
+            if (t.zone == zone && s >= t.first && s < t.last)
+                return date::local_seconds{Seconds{s + t.offset_at(s)}};
+            return zone->to_local(tp);
+        }
+
+        /// Zamiana czasu lokalnego strefy na chwilę UTC.
+        /// Czas niejednoznaczny daje wcześniejszą z chwil, nieistniejący przesuwany jest o lukę
+        /// (niezależnie od tego, czy czas mieści się w zakresie tablicy).
+        static date::sys_seconds to_sys(date::time_zone const* const zone, date::local_seconds const tp) {
+            auto const& t = table();
+            auto const s = tp.time_since_epoch().count();
+            if (t.zone == zone && s >= t.local.front() && s < t.last)
+                return date::sys_seconds{Seconds{t.to_utc(s)}};
+            // Ta sama zasada co w tablicy (Table::to_utc): czas niejednoznaczny daje wcześniejszą chwilę,
+            // nieistniejący przesuwany jest o lukę - obie wynikają z przesunięcia sprzed zmiany.
+            auto const info = zone->get_info(tp);
+            return date::sys_seconds{tp.time_since_epoch() - info.first.offset};
+        }
+
+    private:
+        static inline std::atomic<Table const*> current_{nullptr};
+        static inline std::once_flag default_once_{};
+
+        static Table const* build(date::time_zone const* const zone, int const first_year, int const last_year) {
+            auto table = new Table{.zone = zone};
+            auto t = date::sys_seconds{date::sys_days{date::year{first_year} / 1 / 1}};
+            auto const end = date::sys_seconds{date::sys_days{date::year{last_year + 1} / 1 / 1}};
+            table->first = t.time_since_epoch().count();
+            table->last = end.time_since_epoch().count();
+            while (t < end) {
+                auto const info = zone->get_info(t);
+                auto const begin = std::max(t, info.begin).time_since_epoch().count();
+                auto const offset = static_cast<i32>(info.offset.count());
+                // Kolejne przedziały mogą różnić się tylko skrótem nazwy - łączymy je.
+                if (table->offset.empty() || table->offset.back() != offset) {
+                    table->utc.push_back(begin);
+                    table->local.push_back(begin + offset);
+                    table->offset.push_back(offset);
+                }
+                t = info.end;
+            }
+            return table;
+        }
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                   t e k s t   d a t y                         *
+    *                                                               *
+    ****************************************************************/
+
+    /// Długość tekstu "YYYY-MM-DD HH:MM:SS".
+    inline constexpr size_t DatetimeSize = 19;
+    /// Długość tekstu ISO-8601 z przesunięciem strefy "YYYY-MM-DDTHH:MM:SS+hh:mm".
+    inline constexpr size_t IsoDatetimeSize = 25;
+
+    /// Wynik odczytu daty i czasu z tekstu.
+    struct ParsedDatetime {
+        i64 seconds{};      // sekundy od początku epoki (czasu lokalnego lub UTC - patrz 'utc')
+        u32 nanoseconds{};  // część ułamkowa sekundy (jeśli była w tekście)
+        bool utc{};         // czy tekst zawierał strefę ('Z' lub ±hh:mm), tzn. 'seconds' to czas UTC
+    };
+
+    namespace detail {
+        /// Odczyt 'n' cyfr dziesiętnych (wynik ujemny, gdy któryś znak nie jest cyfrą).
+        constexpr i32 read_digits(char const* const p, size_t const n) noexcept {
+            i32 value = 0;
+            for (size_t i = 0; i < n; ++i) {
+                auto const digit = static_cast<u8>(p[i] - '0');
+                if (digit > 9)
+                    return -1;
+                value = value * 10 + digit;
+            }
+            return value;
+        }
+
+        /// Zapis liczby na dwóch cyfrach.
+        constexpr void write2(char* const out, u32 const value) noexcept {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        }
+    }
+
+    /// Odczyt daty i czasu w formacie "YYYY-MM-DD HH:MM:SS" lub ISO-8601 ("YYYY-MM-DDTHH:MM:SS"
+    /// z opcjonalną częścią ułamkową i strefą: 'Z', ±hh:mm, ±hhmm lub ±hh).
+    /// Tekst analizowany jest bezpośrednio - bez strumieni i alokacji.
+    /// \param text Tekst do odczytu (cały musi być datą).
+    /// \return Odczytany czas lub błąd: invalid_argument (format), result_out_of_range (wartość pola).
+    constexpr Result<ParsedDatetime, Errc> parse_datetime(StringView const text) noexcept {
+        if (text.size() < DatetimeSize)
+            return Failure(Errc::invalid_argument);
+        auto const p = text.data();
+        if (p[4] != '-' || p[7] != '-' || (p[10] != ' ' && p[10] != 'T') || p[13] != ':' || p[16] != ':')
+            return Failure(Errc::invalid_argument);
+
+        auto const year = detail::read_digits(p, 4);
+        auto const month = detail::read_digits(p + 5, 2);
+        auto const day = detail::read_digits(p + 8, 2);
+        auto const hour = detail::read_digits(p + 11, 2);
+        auto const minute = detail::read_digits(p + 14, 2);
+        auto const second = detail::read_digits(p + 17, 2);
+        if ((year | month | day | hour | minute | second) < 0)
+            return Failure(Errc::invalid_argument);
+        if (month < 1 || month > 12 || day < 1 || static_cast<u32>(day) > days_in_month(year, static_cast<u32>(month))
+            || hour > 23 || minute > 59 || second > 59)
+            return Failure(Errc::result_out_of_range);
+
+        ParsedDatetime result{
+            .seconds = days_from_civil(year, static_cast<u32>(month), static_cast<u32>(day)) * SecondsPerDay
+                + hour * 3600 + minute * 60 + second
+        };
+
+        auto i = DatetimeSize;
+        // Część ułamkowa sekundy (cyfry poza nanosekundami są pomijane).
+        if (i < text.size() && (p[i] == '.' || p[i] == ',')) {
+            auto const first = ++i;
+            u32 scale = 100'000'000;
+            for (; i < text.size() && static_cast<u8>(p[i] - '0') < 10; ++i, scale /= 10)
+                result.nanoseconds += static_cast<u32>(p[i] - '0') * scale;
+            if (i == first)
+                return Failure(Errc::invalid_argument);
+        }
+        // Strefa czasowa.
+        if (i < text.size()) {
+            if (p[i] == 'Z' || p[i] == 'z')
+                ++i;
+            else if (p[i] == '+' || p[i] == '-') {
+                auto const sign = (p[i] == '-') ? -1 : 1;
+                auto const rest = text.size() - i - 1;
+                if (rest != 2 && rest != 4 && !(rest == 5 && p[i + 3] == ':'))
+                    return Failure(Errc::invalid_argument);
+                auto const hh = detail::read_digits(p + i + 1, 2);
+                auto const mm = (rest == 2) ? 0 : detail::read_digits(p + i + rest - 1, 2);
+                if (hh < 0 || mm < 0)
+                    return Failure(Errc::invalid_argument);
+                if (hh > 23 || mm > 59)
+                    return Failure(Errc::result_out_of_range);
+                result.seconds -= sign * (hh * 3600 + mm * 60);
+                i = text.size();
+            }
+            else
+                return Failure(Errc::invalid_argument);
+            result.utc = true;
+        }
+        if (i != text.size())
+            return Failure(Errc::invalid_argument);
+        return result;
+    }
+
+    /// Zapis czasu w formacie "YYYY-MM-DD HH:MM:SS" (lata 0-9999).
+    /// \param out Bufor na DatetimeSize znaków,
+    /// \param seconds Sekundy od początku epoki (czas, który ma zostać zapisany),
+    /// \param separator Znak pomiędzy datą i czasem (' ' lub 'T').
+    /// \return Wskaźnik za ostatnim zapisanym znakiem.
+    constexpr char* format_datetime(char* const out, i64 const seconds, char const separator = ' ') noexcept {
+        auto const days = floor_div(seconds, SecondsPerDay);
+        auto const sod = static_cast<u32>(seconds - days * SecondsPerDay);
+        auto const [y, m, d] = civil_from_days(days);
+        auto const year = static_cast<u32>(y);
+        detail::write2(out, year / 100 % 100);
+        detail::write2(out + 2, year % 100);
+        out[4] = '-';
+        detail::write2(out + 5, m);
+        out[7] = '-';
+        detail::write2(out + 8, d);
+        out[10] = separator;
+        detail::write2(out + 11, sod / 3600);
+        out[13] = ':';
+        detail::write2(out + 14, sod / 60 % 60);
+        out[16] = ':';
+        detail::write2(out + 17, sod % 60);
+        return out + DatetimeSize;
+    }
+
+    /// Zapis czasu w formacie ISO-8601 z przesunięciem strefy: "YYYY-MM-DDTHH:MM:SS+hh:mm".
+    /// \param out Bufor na IsoDatetimeSize znaków,
+    /// \param utc Sekundy od początku epoki (UTC),
+    /// \param offset Przesunięcie strefy względem UTC w sekundach.
+    /// \return Wskaźnik za ostatnim zapisanym znakiem.
+    constexpr char* format_iso8601(char* const out, i64 const utc, i64 const offset) noexcept {
+        auto p = format_datetime(out, utc + offset, 'T');
+        auto const magnitude = static_cast<u32>(offset < 0 ? -offset : offset);
+        *p++ = offset < 0 ? '-' : '+';
+        detail::write2(p, magnitude / 3600);
+        p[2] = ':';
+        detail::write2(p + 3, magnitude / 60 % 60);
+        return p + 5;
+    }
+
     class Datime {
-        date::time_zone const* zone =  date::locate_zone("Europe/Warsaw");
-        zoned_time_t tp_{};
+        date::time_zone const* zone = TimeZone::zone();
+        zoned_time_t tp_;
     public:
         struct Date { int y{}, m{}, d{}; };
         struct Time { int h{}, m{}, s{}; };
 
         /// CTOR default: aktualna data i czas na komputerze.
-        Datime() {
-            auto const now = std::chrono::system_clock::now();
-            tp_ = date::make_zoned(zone, std::chrono::floor<Seconds>(now));
-        }
+        Datime() : tp_{zone, std::chrono::floor<Seconds>(std::chrono::system_clock::now())} {}
 
         /// CTOR: data i czas z tekstu.
-        explicit Datime(String const& str) {
-            std::stringstream ss{str};
-            date::local_time<Seconds> tmp;
-            date::from_stream(ss, "%F %X", tmp);
-            tp_ = make_zoned(zone, tmp);
-        }
+        /// Formaty "YYYY-MM-DD HH:MM:SS" i ISO-8601 odczytywane są bezpośrednio,
+        /// pozostałe (np. bez zer wiodących) przez date::from_stream.
+        explicit Datime(String const& str) : tp_{from_text(str)} {}
 
         /// CTOR: data i czas z liczby sekund od początku epoki.
-        explicit Datime(i64 const timestamp) {
-            auto const tp = std::chrono::system_clock::from_time_t(timestamp);
-            tp_ = date::make_zoned(zone, std::chrono::floor<Seconds>(tp));
-        }
+        explicit Datime(i64 const timestamp) : tp_{zone, date::sys_seconds{Seconds{timestamp}}} {}
 
         /// CTOR: data i czas z lokalnego punktu-w-czasie
         explicit Datime(zoned_time_t const tp) : tp_{tp} {}
 
+        /// Odczyt daty i czasu z tekstu ("YYYY-MM-DD HH:MM:SS" lub ISO-8601) bez strumieni i alokacji.
+        /// Tekst bez strefy to czas lokalny, ze strefą - wskazana chwila.
+        /// \return Obiekt lub błąd (invalid_argument, result_out_of_range).
+        static Result<Datime, Errc> parse(StringView const text) noexcept {
+            auto const parsed = parse_datetime(text);
+            if (!parsed)
+                return Failure(parsed.error());
+            return Datime{*parsed};
+        }
+
         /// CTOR: data i czas ze struktur daty i czasu.
         explicit Datime(Date const dt, Time const tm) : tp_{from_components(dt, tm)} {}
 
@@ -98,12 +381,32 @@ namespace bee {
 
         /// Prezentacja daty i czasy w postaci tekstu (mp. "2025-11-11 19:09:28").
         [[nodiscard]] String to_string() const noexcept {
-            return date::format("%F %X", tp_.get_local_time());
+            char buffer[DatetimeSize];
+            return String{buffer, format_to(buffer)};
+        }
+
+        /// Prezentacja w formacie ISO-8601 z przesunięciem strefy (np. "2025-11-11T19:09:28+01:00").
+        [[nodiscard]] String to_iso_string() const noexcept {
+            char buffer[IsoDatetimeSize];
+            return String{buffer, format_iso_to(buffer)};
+        }
+
+        /// Zapis "YYYY-MM-DD HH:MM:SS" (czas lokalny) do bufora na DatetimeSize znaków.
+        /// \return Wskaźnik za ostatnim zapisanym znakiem.
+        char* format_to(char* const out) const noexcept {
+            return format_datetime(out, local_time().time_since_epoch().count());
+        }
+
+        /// Zapis ISO-8601 z przesunięciem strefy do bufora na IsoDatetimeSize znaków.
+        /// \return Wskaźnik za ostatnim zapisanym znakiem.
+        char* format_iso_to(char* const out) const noexcept {
+            auto const utc = timestamp();
+            return format_iso8601(out, utc, local_time().time_since_epoch().count() - utc);
         }
 
         /// Zwraca informację o dacie.
         [[nodiscard]] Date date() const noexcept {
-            auto const days = date::floor<Days>(tp_.get_local_time());
+            auto const days = date::floor<Days>(local_time());
             date::year_month_day ymd{days};
             auto const year = static_cast<int>(ymd.year());
             auto const month = static_cast<int>(static_cast<unsigned>(ymd.month()));
@@ -113,8 +416,8 @@ namespace bee {
 
         /// Zwraca informację o czasie.
         [[nodiscard]] Time time() const noexcept {
-            auto const days = date::floor<Days>(tp_.get_local_time());
-            date::hh_mm_ss const hms{tp_.get_local_time() - days};
+            auto const days = date::floor<Days>(local_time());
+            date::hh_mm_ss const hms{local_time() - days};
             auto const hour = static_cast<int>(hms.hours().count());
             auto const min = static_cast<int>(hms.minutes().count());
             auto const sec = static_cast<int>(hms.seconds().count());
@@ -123,34 +426,34 @@ namespace bee {
 
         /// Ustawienie czasu. Data pozostaje bez zmian.
         Datime& time(Time const& tm) noexcept {
-            auto const t = date::floor<Days>(tp_.get_local_time())
+            auto const t = date::floor<Days>(local_time())
                 + std::chrono::hours(tm.h)
                 + std::chrono::minutes(tm.m)
                 + std::chrono::seconds(tm.s);
-            tp_ = make_zoned(zone, t);
+            tp_ = from_local(t);
             return *this;
         }
 
         /// Wyzerowanie czasu, zostaje tylko data.
         Datime& clear_time() noexcept {
-            auto const t = date::floor<Days>(tp_.get_local_time())
+            auto const t = date::floor<Days>(local_time())
                 + std::chrono::hours(0)
                 + std::chrono::minutes(0)
                 + std::chrono::seconds(0);
-            tp_ = make_zoned(zone, t);
+            tp_ = from_local(t);
             return *this;
         }
 
         /// Wyzerowanie sekund.
         /// Minuty są zaokrąglane w zależności od zastanej liczby sekund.
         Datime& clear_seconds() noexcept {
-            auto const days = date::floor<Days>(tp_.get_local_time());
-            date::hh_mm_ss const hms{tp_.get_local_time() - days};
-            auto t = date::floor<Days>(tp_.get_local_time())
+            auto const days = date::floor<Days>(local_time());
+            date::hh_mm_ss const hms{local_time() - days};
+            auto t = date::floor<Days>(local_time())
                     + hms.hours()
                     + hms.minutes()
                     + std::chrono::seconds(hms.seconds().count() >= 30 ? 60 : 0);
-            tp_ = make_zoned(zone, t);
+            tp_ = from_local(t);
             return *this;
         }
 
@@ -161,6 +464,9 @@ namespace bee {
         }
 
         /// Zwraca liczbę minut od wskazanego obiektu data-czas.
+        /// Uwaga: wynik to 'other - this' (dodatni, gdy 'other' jest późniejszy), a obie chwile
+        /// są najpierw zaokrąglane w dół do pełnych minut. Funkcje *_since klas BasicTimestamp
+        /// liczą 'this - other' i zaokrąglają różnicę - przy przenoszeniu kodu zmienia się znak.
         /// \return Liczba minut.
         [[nodiscard]] i64 minutes_since(Datime const& other) const noexcept {
             auto const a = date::floor<Minutes>(tp_.get_sys_time());
@@ -182,12 +488,12 @@ namespace bee {
         /// \param n Liczba dni przesunięcia (dodatnia lub ujemna)
         /// \return Obiekt nowej daty.
         [[nodiscard]] Datime add_days(int const n) const noexcept {
-            auto const days = date::floor<Days>(tp_.get_local_time());
-            date::hh_mm_ss const hms{tp_.get_local_time() - days};
+            auto const days = date::floor<Days>(local_time());
+            date::hh_mm_ss const hms{local_time() - days};
 
             auto const added = days + std::chrono::days(n);
             auto const secs = added + hms.hours() + hms.minutes() + hms.seconds();
-            return Datime(make_zoned(zone, secs));
+            return Datime(from_local(secs));
         }
 
         /// Wyznaczanie obiektu daty dla następnego dnia.
@@ -203,7 +509,7 @@ namespace bee {
         /// Zwraca numer tego dnia w tym tygodniu.
         /// 1-poniedziałek, 2-wtorek, ... , 7-niedziela.
         [[nodiscard]] auto week_day() const noexcept {
-            auto const wd = date::floor<Days>(tp_.get_local_time());
+            auto const wd = date::floor<Days>(local_time());
             return date::weekday(wd).iso_encoding();
         }
 
@@ -215,14 +521,235 @@ namespace bee {
         }
 
     private:
+        /// CTOR: data i czas z odczytanego tekstu (bez domyślnego zoned_time, który szuka strefy w bazie tz).
+        explicit Datime(ParsedDatetime const& parsed) : tp_{from_parsed(parsed)} {}
+
         [[nodiscard]] zoned_time_t from_components(Date const dt, Time const tm) const noexcept {
             namespace chrono = std::chrono;
             date::year_month_day const ymd = date::year(dt.y) / dt.m / dt.d;
             auto const days = static_cast<date::local_days>(ymd);
             auto const time = days + chrono::hours{tm.h} + chrono::minutes{tm.m} + chrono::seconds{tm.s};
-            return date::make_zoned(zone, time);
+            return from_local(time);
+        }
+
+        /// Czas lokalny obiektu (przez tablicę przesunięć strefy).
+        [[nodiscard]] date::local_seconds local_time() const noexcept {
+            return TimeZone::to_local(zone, tp_.get_sys_time());
+        }
+
+        /// Punkt-w-czasie dla czasu lokalnego strefy obiektu.
+        [[nodiscard]] zoned_time_t from_local(date::local_seconds const t) const noexcept {
+            return zoned_time_t{zone, TimeZone::to_sys(zone, t)};
+        }
+
+        /// Punkt-w-czasie dla tekstu (patrz CTOR z tekstu).
+        [[nodiscard]] zoned_time_t from_text(String const& str) const {
+            if (auto const parsed = parse_datetime(str))
+                return from_parsed(*parsed);
+            std::stringstream ss{str};
+            date::local_time<Seconds> tmp;
+            date::from_stream(ss, "%F %X", tmp);
+            return from_local(tmp);
+        }
+
+        /// Punkt-w-czasie dla odczytanego tekstu.
+        [[nodiscard]] zoned_time_t from_parsed(ParsedDatetime const& parsed) const noexcept {
+            Seconds const seconds{parsed.seconds};
+            if (parsed.utc)
+                return zoned_time_t{zone, date::sys_seconds{seconds}};
+            return from_local(date::local_seconds{seconds});
+        }
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                     T i m e s t a m p                         *
+    *                                                               *
+    ****************************************************************/
+
+    /// Zwarta chwila w czasie: tylko liczba jednostek (sekund, mikrosekund, ...) od początku epoki (UTC).
+    /// W odróżnieniu od Datime zajmuje 8 bajtów, jest trywialnie kopiowalna, a porównania
+    /// to porównania liczb - nadaje się do przechowywania milionów chwil w posortowanych wektorach.
+    /// Pola czasu lokalnego (data, czas, dzień tygodnia) wyznaczane są dopiero na żądanie
+    /// przez tablicę przesunięć strefy bieżącej (TimeZone).
+    template<typename Duration>
+    class BasicTimestamp {
+        i64 count_{};
+    public:
+        using duration = Duration;
+        /// Liczba jednostek w sekundzie.
+        static constexpr i64 PerSecond = std::chrono::duration_cast<Duration>(Seconds{1}).count();
+
+        constexpr BasicTimestamp() noexcept = default;
+        /// CTOR: chwila z liczby jednostek od początku epoki.
+        constexpr explicit BasicTimestamp(i64 const count) noexcept : count_{count} {}
+        /// CTOR: chwila z obiektu Datime (dokładność do sekundy).
+        explicit BasicTimestamp(Datime const& dt) noexcept : count_{dt.timestamp() * PerSecond} {}
+
+        /// Chwila z liczby sekund od początku epoki.
+        static constexpr BasicTimestamp from_seconds(i64 const seconds) noexcept {
+            return BasicTimestamp{seconds * PerSecond};
+        }
+
+        /// Bieżąca chwila (zegar systemowy).
+        static BasicTimestamp now() noexcept {
+            auto const now = std::chrono::system_clock::now().time_since_epoch();
+            return BasicTimestamp{std::chrono::floor<Duration>(now).count()};
+        }
+
+        /// Liczba jednostek od początku epoki.
+        [[nodiscard]] constexpr i64 count() const noexcept {
+            return count_;
+        }
+
+        /// Liczba pełnych sekund od początku epoki.
+        [[nodiscard]] constexpr i64 seconds() const noexcept {
+            return floor_div(count_, PerSecond);
+        }
+
+        /// Klucz do sortowania pozycyjnego (radix sort): porządek liczb bez znaku zgodny z porządkiem chwil.
+        [[nodiscard]] constexpr u64 radix_key() const noexcept {
+            return static_cast<u64>(count_) ^ (u64{1} << 63);
+        }
+
+        constexpr auto operator<=>(BasicTimestamp const&) const noexcept = default;
+
+        /// Przesunięcie o wskazaną liczbę jednostek.
+        constexpr BasicTimestamp operator+(i64 const n) const noexcept {
+            return BasicTimestamp{count_ + n};
+        }
+        constexpr BasicTimestamp operator-(i64 const n) const noexcept {
+            return BasicTimestamp{count_ - n};
+        }
+        /// Odległość między chwilami w jednostkach.
+        constexpr i64 operator-(BasicTimestamp const rhs) const noexcept {
+            return count_ - rhs.count_;
+        }
+
+        /// Ta sama chwila z inną dokładnością (przy zmniejszaniu dokładności - zaokrąglenie w dół).
+        template<typename To>
+        [[nodiscard]] constexpr BasicTimestamp<To> cast() const noexcept {
+            return BasicTimestamp<To>{std::chrono::floor<To>(Duration{count_}).count()};
+        }
+
+        /// Czas, jaki upłynął od wskazanej chwili: 'this - other' (ujemny, gdy wskazana chwila
+        /// jest późniejsza) w jednostkach 'To'. Zaokrąglana w dół jest różnica, nie same chwile
+        /// (inaczej niż w Datime::minutes_since, które liczy 'other - this'). Chwile mogą mieć różne dokładności.
+        template<typename To, typename Other>
+        [[nodiscard]] constexpr i64 since(BasicTimestamp<Other> const other) const noexcept {
+            using Common = std::common_type_t<Duration, Other>;
+            auto const delta = Common{Duration{count_}} - Common{Other{other.count()}};
+            return std::chrono::floor<To>(delta).count();
+        }
+        /// Liczba nanosekund od wskazanej chwili: 'this - other', różnica zaokrąglona w dół (patrz since).
+        template<typename Other>
+        [[nodiscard]] constexpr i64 nanoseconds_since(BasicTimestamp<Other> const other) const noexcept {
+            return since<std::chrono::nanoseconds>(other);
+        }
+        /// Liczba mikrosekund od wskazanej chwili: 'this - other', różnica zaokrąglona w dół (patrz since).
+        template<typename Other>
+        [[nodiscard]] constexpr i64 microseconds_since(BasicTimestamp<Other> const other) const noexcept {
+            return since<std::chrono::microseconds>(other);
+        }
+        /// Liczba milisekund od wskazanej chwili: 'this - other', różnica zaokrąglona w dół (patrz since).
+        template<typename Other>
+        [[nodiscard]] constexpr i64 milliseconds_since(BasicTimestamp<Other> const other) const noexcept {
+            return since<std::chrono::milliseconds>(other);
+        }
+        /// Liczba sekund od wskazanej chwili: 'this - other', różnica zaokrąglona w dół (patrz since).
+        template<typename Other>
+        [[nodiscard]] constexpr i64 seconds_since(BasicTimestamp<Other> const other) const noexcept {
+            return since<Seconds>(other);
+        }
+        /// Liczba minut od wskazanej chwili: 'this - other', różnica zaokrąglona w dół (patrz since).
+        template<typename Other>
+        [[nodiscard]] constexpr i64 minutes_since(BasicTimestamp<Other> const other) const noexcept {
+            return since<Minutes>(other);
+        }
+
+        /// Obiekt Datime dla tej chwili (w strefie bieżącej).
+        [[nodiscard]] Datime to_datime() const noexcept {
+            return Datime(seconds());
+        }
+
+        /// Czas lokalny strefy bieżącej: sekundy od początku epoki.
+        [[nodiscard]] i64 local_seconds() const noexcept {
+            auto const s = seconds();
+            return TimeZone::to_local(TimeZone::zone(), date::sys_seconds{Seconds{s}}).time_since_epoch().count();
+        }
+
+        /// Data (czas lokalny).
+        [[nodiscard]] Datime::Date date() const noexcept {
+            auto const civil = civil_from_days(floor_div(local_seconds(), SecondsPerDay));
+            return {civil.y, static_cast<int>(civil.m), static_cast<int>(civil.d)};
+        }
+
+        /// Czas (lokalny, z dokładnością do sekundy).
+        [[nodiscard]] Datime::Time time() const noexcept {
+            auto const local = local_seconds();
+            auto const sod = static_cast<int>(local - floor_div(local, SecondsPerDay) * SecondsPerDay);
+            return {sod / 3600, sod / 60 % 60, sod % 60};
+        }
+
+        /// Numer dnia tygodnia (czas lokalny): 1-poniedziałek, ... , 7-niedziela.
+        [[nodiscard]] u32 week_day() const noexcept {
+            return iso_weekday_from_days(floor_div(local_seconds(), SecondsPerDay));
+        }
+
+        /// Prezentacja "YYYY-MM-DD HH:MM:SS" (czas lokalny).
+        [[nodiscard]] String to_string() const noexcept {
+            char buffer[DatetimeSize];
+            return String{buffer, format_datetime(buffer, local_seconds())};
         }
     };
+
+    /// Chwila z dokładnością do sekundy.
+    using Timestamp = BasicTimestamp<Seconds>;
+    /// Chwila z dokładnością do milisekundy.
+    using MilliTimestamp = BasicTimestamp<std::chrono::milliseconds>;
+    /// Chwila z dokładnością do mikrosekundy.
+    using MicroTimestamp = BasicTimestamp<std::chrono::microseconds>;
+    /// Chwila z dokładnością do nanosekundy (zakres: lata 1678-2262).
+    using NanoTimestamp = BasicTimestamp<std::chrono::nanoseconds>;
+
+    static_assert(sizeof(Timestamp) == 8 && std::is_trivially_copyable_v<Timestamp>);
+    static_assert(sizeof(MicroTimestamp) == 8 && std::is_trivially_copyable_v<MicroTimestamp>);
+    static_assert(sizeof(NanoTimestamp) == 8 && std::is_trivially_copyable_v<NanoTimestamp>);
+
+    /// Odczyt kolumny tekstów z datą i czasem (np. po jednym z każdej linii logu).
+    /// \param texts Teksty "YYYY-MM-DD HH:MM:SS" lub ISO-8601 (bez strefy - czas lokalny strefy bieżącej),
+    /// \param out Bufor na wyniki: sekundy od początku epoki (UTC).
+    /// \return Sukces lub numer pierwszego tekstu, którego nie udało się odczytać (z kodem błędu).
+    inline Result<Unit, ParseError> parse_datetimes(Span<const StringView> const texts, Span<i64> const out) noexcept {
+        if (out.size() < texts.size())
+            return Failure(ParseError{.index = out.size(), .code = Errc::no_buffer_space});
+        auto const zone = TimeZone::zone();
+        for (size_t i = 0; i < texts.size(); ++i) {
+            auto const parsed = parse_datetime(texts[i]);
+            if (!parsed)
+                return Failure(ParseError{.index = i, .code = parsed.error()});
+            out[i] = parsed->utc
+                ? parsed->seconds
+                : TimeZone::to_sys(zone, date::local_seconds{Seconds{parsed->seconds}}).time_since_epoch().count();
+        }
+        return Success;
+    }
+
+    /// Zapis wielu chwil jako "YYYY-MM-DD HH:MM:SS" (czas lokalny strefy bieżącej) na końcu tekstu.
+    /// \param seconds Sekundy od początku epoki (UTC),
+    /// \param out Tekst, do którego dopisujemy (jedna rezerwacja pamięci),
+    /// \param delimiter Znak dopisywany po każdej dacie.
+    inline void format_datetimes(Span<const i64> const seconds, String& out, char const delimiter = '\n') {
+        auto const zone = TimeZone::zone();
+        auto const start = out.size();
+        out.resize(start + seconds.size() * (DatetimeSize + 1));
+        auto p = out.data() + start;
+        for (auto const utc : seconds) {
+            auto const local = TimeZone::to_local(zone, date::sys_seconds{Seconds{utc}});
+            p = format_datetime(p, local.time_since_epoch().count());
+            *p++ = delimiter;
+        }
+    }
 }
 
 template<>
@@ -0,0 +1,184 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "dictionary.h"
+#include <zlib.h>
+#include <queue>
+
+namespace bee {
+    namespace {
+        /// Długość n-gramów, których częstość wystąpień oceniamy.
+        constexpr size_t GramSize = 8;
+        /// Długość fragmentu przenoszonego z próbki do słownika.
+        constexpr size_t SegmentSize = 64;
+        /// Górna granica łącznego rozmiaru analizowanych próbek.
+        constexpr size_t MaxSampleBytes = 128 * Dictionary::MaxSize;
+
+        /// Fragment próbki, kandydat do umieszczenia w słowniku.
+        struct Segment {
+            u64 score{};
+            StringView text{};
+            bool operator<(Segment const& rhs) const noexcept {
+                return score < rhs.score;
+            }
+        };
+
+        /// Ocena fragmentu: suma częstości jego n-gramów występujących więcej niż raz.
+        u64 score(StringView const text, Map<StringView, u32> const& freq) noexcept {
+            u64 total{};
+            for (size_t i = 0; i + GramSize <= text.size(); ++i)
+                if (auto const it = freq.find(text.substr(i, GramSize)); it != freq.end() && it->second > 1)
+                    total += it->second;
+            return total;
+        }
+
+        u32 adler(Span<const char> const data) noexcept {
+            auto const init = adler32(0, nullptr, 0);
+            return static_cast<u32>(adler32_z(init, reinterpret_cast<Bytef const*>(data.data()), data.size()));
+        }
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                       D i c t i o n a r y                         *
+    *                                                                   *
+    ********************************************************************/
+
+    Dictionary::Dictionary(Vector<char> data) noexcept : data_{std::move(data)} {
+        // Z dłuższego słownika zlib i tak użyje tylko końcówki mieszczącej się w oknie.
+        if (data_.size() > MaxSize)
+            data_.erase(data_.begin(), data_.end() - MaxSize);
+        id_ = adler(data_);
+    }
+
+    Dictionary Dictionary::train(Span<const Span<const char>> const samples, size_t const max_size) noexcept {
+        // Częstości n-gramów we wszystkich próbkach.
+        Map<StringView, u32> freq{};
+        size_t analysed = 0;
+        for (auto const sample : samples) {
+            if (analysed >= MaxSampleBytes)
+                break;
+            StringView const text{sample.data(), std::min(sample.size(), MaxSampleBytes - analysed)};
+            analysed += text.size();
+            for (size_t i = 0; i + GramSize <= text.size(); ++i)
+                ++freq[text.substr(i, GramSize)];
+        }
+
+        // Kandydaci: fragmenty próbek zachodzące na siebie w połowie.
+        std::priority_queue<Segment> queue{};
+        analysed = 0;
+        for (auto const sample : samples) {
+            if (analysed >= MaxSampleBytes)
+                break;
+            StringView const text{sample.data(), std::min(sample.size(), MaxSampleBytes - analysed)};
+            analysed += text.size();
+            for (size_t offset = 0; offset < text.size(); offset += SegmentSize / 2) {
+                auto const segment = text.substr(offset, SegmentSize);
+                if (auto const value = score(segment, freq))
+                    queue.push({value, segment});
+                if (offset + SegmentSize >= text.size())
+                    break;
+            }
+        }
+
+        // Wybór zachłanny z leniwą aktualizacją ocen: po wybraniu fragmentu jego n-gramy
+        // przestają się liczyć, więc oceny pozostałych kandydatów mogą tylko maleć.
+        auto const limit = std::min(max_size, MaxSize);
+        Vector<StringView> picked{};
+        size_t size = 0;
+        while (size < limit && !queue.empty()) {
+            auto segment = queue.top();
+            queue.pop();
+            auto const current = score(segment.text, freq);
+            if (current == 0)
+                continue;
+            if (!queue.empty() && current < queue.top().score) {
+                segment.score = current;
+                queue.push(segment);
+                continue;
+            }
+
+            picked.push_back(segment.text);
+            size += segment.text.size();
+            for (size_t i = 0; i + GramSize <= segment.text.size(); ++i)
+                if (auto const it = freq.find(segment.text.substr(i, GramSize)); it != freq.end())
+                    it->second = 0;
+        }
+
+        // Najcenniejsze fragmenty na końcu słownika.
+        Vector<char> data{};
+        data.reserve(size);
+        for (auto it = picked.rbegin(); it != picked.rend(); ++it)
+            data.insert(data.end(), it->begin(), it->end());
+        if (data.size() > limit)
+            data.erase(data.begin(), data.end() - static_cast<std::ptrdiff_t>(limit));
+        return Dictionary(std::move(data));
+    }
+
+    Result<Vector<char>, Error> Dictionary::compress(Span<const char> const plain, int const level) const noexcept {
+        auto& context = GzipContext::local().options({.level = level, .format = Format::Zlib}).dictionary(data_);
+        auto result = context.compress(plain);
+        context.dictionary({});
+        return result;
+    }
+
+    Result<size_t, Error> Dictionary::compress_into(Span<const char> const plain, Span<char> const out, int const level) const noexcept {
+        auto& context = GzipContext::local().options({.level = level, .format = Format::Zlib}).dictionary(data_);
+        auto const result = context.compress_into(plain, out);
+        context.dictionary({});
+        return result;
+    }
+
+    Result<Vector<char>, Error> Dictionary::decompress(Span<const char> const compressed) const noexcept {
+        if (auto const ok = check(compressed); !ok)
+            return Failure(ok.error());
+        auto& context = GzipContext::local().dictionary(data_);
+        auto result = context.decompress(compressed, {.format = Format::Zlib});
+        context.dictionary({});
+        return result;
+    }
+
+    Result<size_t, Error> Dictionary::decompress_into(Span<const char> const compressed, Span<char> const out) const noexcept {
+        if (auto const ok = check(compressed); !ok)
+            return Failure(ok.error());
+        auto& context = GzipContext::local().dictionary(data_);
+        auto const result = context.decompress_into(compressed, out, {.format = Format::Zlib});
+        context.dictionary({});
+        return result;
+    }
+
+    /// Sprawdzenie, czy dane zostały skompresowane z użyciem tego słownika.
+    Result<Unit, Error> Dictionary::check(Span<const char> const compressed) const noexcept {
+        auto const id = dictionary_id(compressed);
+        if (!id && !empty())
+            return Failure(Error(Z_DATA_ERROR, "dictionary mismatch", "stream does not use a dictionary"));
+        if (id && *id != id_)
+            return Failure(Error(Z_DATA_ERROR, "dictionary mismatch", std::format("expected {:08x}, got {:08x}", id_, *id)));
+        return Success;
+    }
+}
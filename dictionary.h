@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "error.h"
+#include "gzip.h"
+
+namespace bee {
+    /// Identyfikator słownika zapisany w nagłówku strumienia zlib (pole DICTID).
+    /// Pozwala wybrać właściwy słownik przed dekompresją.
+    /// \param compressed Dane w formacie zlib.
+    /// \return Identyfikator słownika lub nic, jeśli strumień nie używa słownika.
+    constexpr Option<u32> dictionary_id(Span<const char> const compressed) noexcept {
+        if (compressed.size() < 6)
+            return {};
+        auto const cmf = static_cast<u8>(compressed[0]);
+        auto const flg = static_cast<u8>(compressed[1]);
+        if ((cmf & 0x0f) != 8 || (cmf * 256 + flg) % 31 != 0 || !(flg & 0x20))
+            return {};
+        u32 id{};
+        for (auto i = 2; i < 6; ++i)
+            id = (id << 8) | static_cast<u8>(compressed[i]);
+        return id;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                       D i c t i o n a r y                     *
+    *                                                               *
+    ****************************************************************/
+
+    /// Słownik kompresji dla krótkich, podobnych do siebie komunikatów (np. rekordy JSON/CSV).
+    /// Kompresor i dekompresor zaczynają z oknem wypełnionym treścią słownika,
+    /// więc już pierwsze bajty komunikatu mogą się do niej odwoływać.
+    /// Dane kompresowane są w formacie zlib, którego nagłówek zawiera identyfikator
+    /// słownika (Adler-32 jego treści), sprawdzany podczas dekompresji.
+    class Dictionary final {
+        Vector<char> data_{};
+        u32 id_{1};
+    public:
+        /// Maksymalny użyteczny rozmiar słownika (rozmiar okna deflate).
+        static constexpr size_t MaxSize = 32 * 1024;
+
+        Dictionary() = default;
+        /// CTOR: słownik z gotowej treści (zachowywane jest ostatnie MaxSize bajtów).
+        explicit Dictionary(Vector<char> data) noexcept;
+        Dictionary(Dictionary const&) = default;
+        Dictionary(Dictionary&&) = default;
+        Dictionary& operator=(Dictionary const&) = default;
+        Dictionary& operator=(Dictionary&&) = default;
+        ~Dictionary() = default;
+
+        /// Utworzenie słownika na podstawie przykładowych komunikatów.
+        /// Wybierane są fragmenty zawierające najczęściej powtarzające się ciągi bajtów,
+        /// najcenniejsze trafiają na koniec słownika (najkrótsze odległości w deflate).
+        /// \param samples Przykładowe komunikaty,
+        /// \param max_size Maksymalny rozmiar słownika.
+        /// \return Wytrenowany słownik.
+        static Dictionary train(Span<const Span<const char>> samples, size_t max_size = MaxSize) noexcept;
+
+        /// Identyfikator słownika (Adler-32 treści, jak DICTID w nagłówku zlib).
+        [[nodiscard]] u32 id() const noexcept {
+            return id_;
+        }
+        [[nodiscard]] Span<const char> data() const noexcept {
+            return data_;
+        }
+        [[nodiscard]] size_t size() const noexcept {
+            return data_.size();
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return data_.empty();
+        }
+
+        /// Kompresja bajtów z użyciem słownika (format zlib).
+        /// \param plain Ciąg bajtów, który ma być kompresowany,
+        /// \param level Poziom kompresji (0-9).
+        /// \return Wektor bajtów po kompresji lub błąd.
+        [[nodiscard]] Result<Vector<char>, Error> compress(Span<const char> plain, int level = 6) const noexcept;
+
+        /// Kompresja bajtów z użyciem słownika do bufora wołającego.
+        [[nodiscard]] Result<size_t, Error> compress_into(Span<const char> plain, Span<char> out, int level = 6) const noexcept;
+
+        /// Dekompresja bajtów skompresowanych z użyciem tego słownika.
+        /// \param compressed Ciąg bajtów, który ma być dekompresowany.
+        /// \return Wektor bajtów po dekompresji lub błąd (również przy niezgodności słownika).
+        [[nodiscard]] Result<Vector<char>, Error> decompress(Span<const char> compressed) const noexcept;
+
+        /// Dekompresja bajtów skompresowanych z użyciem tego słownika do bufora wołającego.
+        [[nodiscard]] Result<size_t, Error> decompress_into(Span<const char> compressed, Span<char> out) const noexcept;
+
+    private:
+        [[nodiscard]] Result<Unit, Error> check(Span<const char> compressed) const noexcept;
+    };
+}
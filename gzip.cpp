@@ -27,29 +27,305 @@
 /*------- include files:
 -------------------------------------------------------------------*/
 #include "gzip.h"
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
+#include <zlib.h>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <system_error>
+#include <new>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace bee {
+    namespace {
+        /// Maksymalna porcja danych obsługiwana w jednym wywołaniu zlib (avail_in/avail_out są 32-bitowe).
+        constexpr size_t MaxAvail = std::numeric_limits<uInt>::max();
+
+        /// Utworzenie błędu na podstawie kodu zlib (i ewentualnego komunikatu strumienia).
+        Error zlib_error(int const code, z_stream const* const strm = nullptr) noexcept {
+            if (strm && strm->msg)
+                return Error(code, zError(code), strm->msg);
+            return Error(code, zError(code));
+        }
+
+        /// zlib (bez ZLIB_CONST) przyjmuje niestały wskaźnik na dane wejściowe, choć ich nie modyfikuje.
+        Bytef* in_ptr(char const* const data) noexcept {
+            return reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        }
+
+        Bytef* out_ptr(char* const data) noexcept {
+            return reinterpret_cast<Bytef*>(data);
+        }
+
+        /// Rozmiar okna w bitach ograniczony do zakresu obsługiwanego przez zlib.
+        int window_bits(CompressOptions const& options) noexcept {
+            return std::clamp(options.window_bits, 9, MAX_WBITS);
+        }
+
+        /// Parametr windowBits dla deflateInit2 (format ramki zakodowany w znaku i przesunięciu).
+        int deflate_window_bits(CompressOptions const& options) noexcept {
+            auto const bits = window_bits(options);
+            switch (options.format) {
+                case Format::Gzip: return bits + 16;
+                case Format::Zlib: return bits;
+                case Format::Raw: return -bits;
+            }
+            return bits + 16;
+        }
+
+        /// Parametr windowBits dla inflateInit2 (gzip i zlib rozpoznawane automatycznie).
+        int inflate_window_bits(Format const format) noexcept {
+            return (format == Format::Raw) ? -MAX_WBITS : MAX_WBITS + 32;
+        }
+
+        int zlib_strategy(Strategy const strategy) noexcept {
+            switch (strategy) {
+                case Strategy::Default: return Z_DEFAULT_STRATEGY;
+                case Strategy::Filtered: return Z_FILTERED;
+                case Strategy::Rle: return Z_RLE;
+                case Strategy::HuffmanOnly: return Z_HUFFMAN_ONLY;
+            }
+            return Z_DEFAULT_STRATEGY;
+        }
+
+        /// Zapis liczby 32-bitowej w kolejności little-endian (stopka gzip).
+        void put_u32le(Vector<char>& out, u32 const value) noexcept {
+            for (auto i = 0; i < 4; ++i)
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+
+        /// Zapis liczby 32-bitowej w kolejności big-endian (nagłówek i stopka zlib).
+        void put_u32be(Vector<char>& out, u32 const value) noexcept {
+            for (auto i = 3; i >= 0; --i)
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+
+        /// Strumień deflate (bez nagłówka) wielokrotnego użytku w obrębie jednego wątku.
+        struct RawDeflater {
+            z_stream strm{};
+            int status{};
+
+            explicit RawDeflater(CompressOptions const& options) noexcept {
+                status = deflateInit2(&strm, options.level, Z_DEFLATED, -window_bits(options), options.mem_level, zlib_strategy(options.strategy));
+            }
+            RawDeflater(RawDeflater const&) = delete;
+            RawDeflater& operator=(RawDeflater const&) = delete;
+            ~RawDeflater() {
+                if (status == Z_OK)
+                    deflateEnd(&strm);
+            }
+
+            /// Kompresja jednego bloku.
+            /// Blok nie-ostatni kończony jest przez Z_SYNC_FLUSH (wyrównanie do bajtu),
+            /// dzięki czemu bloki można po prostu skleić.
+            Result<Vector<char>, Error> block(Span<const char> const input, Span<const char> const dictionary, bool const last) noexcept {
+                if (status != Z_OK)
+                    return Failure(zlib_error(status));
+                if (auto const ret = deflateReset(&strm); ret != Z_OK)
+                    return Failure(zlib_error(ret, &strm));
+                if (!dictionary.empty())
+                    if (auto const ret = deflateSetDictionary(&strm, in_ptr(dictionary.data()), static_cast<uInt>(dictionary.size())); ret != Z_OK)
+                        return Failure(zlib_error(ret, &strm));
+
+                // deflateBound nie uwzględnia pustego bloku dodawanego przez Z_SYNC_FLUSH.
+                Vector<char> out(deflateBound(&strm, input.size()) + 16);
+                strm.next_in = in_ptr(input.data());
+                strm.avail_in = static_cast<uInt>(input.size());
+                strm.next_out = out_ptr(out.data());
+                strm.avail_out = static_cast<uInt>(out.size());
+
+                auto const flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+                for (;;) {
+                    auto const ret = deflate(&strm, flush);
+                    if (ret == Z_STREAM_ERROR)
+                        return Failure(zlib_error(ret, &strm));
+                    if (strm.avail_out != 0 && strm.avail_in == 0 && (ret == Z_STREAM_END || !last))
+                        break;
+                    // Zabrakło miejsca - powiększamy bufor i kontynuujemy.
+                    auto const used = out.size() - strm.avail_out;
+                    out.resize(out.size() * 2);
+                    strm.next_out = out_ptr(out.data() + used);
+                    strm.avail_out = static_cast<uInt>(out.size() - used);
+                }
+                out.resize(out.size() - strm.avail_out);
+                return out;
+            }
+        };
+
+        /// Błąd przekroczenia dopuszczalnego rozmiaru danych po dekompresji.
+        Error limit_error() noexcept {
+            return Error(Z_BUF_ERROR, "output size limit exceeded");
+        }
+
+        /// Błąd braku pamięci.
+        Error memory_error() noexcept {
+            return Error(Z_MEM_ERROR, "out of memory");
+        }
+
+        /// Największy bufor przydzielany z góry na podstawie rozmiaru ze stopki gzip.
+        /// Stopka pochodzi z danych wejściowych - większe wyniki bufor osiąga, rosnąc w trakcie dekompresji.
+        constexpr size_t MaxPresize = 64 * 1024 * 1024;
+
+        /// Dekompresja do bufora, który w razie potrzeby jest powiększany (nie ponad limit dekompresora).
+        /// Brak pamięci zgłaszany jest wyjątkiem std::bad_alloc.
+        /// \return Liczba bajtów zapisanych do bufora lub błąd.
+        Result<size_t, Error> inflate_into(GzipDecoder& decoder, Span<const char> input, Vector<char>& buffer, size_t const limit) {
+            size_t size = 0;
+            for (;;) {
+                // Po osiągnięciu limitu dokładamy jeden bajt - jeśli strumień go zażąda, dekompresor zgłosi błąd.
+                if (size == buffer.size())
+                    buffer.resize(std::max(size + 1, std::min(std::max<size_t>(size * 2, 64), limit)));
+                auto const progress = decoder.process(input, Span<char>{buffer}.subspan(size));
+                if (!progress)
+                    return Failure(progress.error());
+                input = input.subspan(progress->consumed);
+                size += progress->produced;
+                if (progress->done)
+                    return size;
+                if (input.empty() && size < buffer.size())
+                    return Failure(Error(Z_BUF_ERROR, "unexpected end of compressed stream"));
+            }
+        }
+
+        /// Rozmiar porcji zapisu do pliku.
+        constexpr size_t FileChunkSize = 1024 * 1024;
+
+        /// Błąd funkcji systemowej (na podstawie errno).
+        Error system_error(std::filesystem::path const& path) noexcept {
+            auto const code = errno;
+            return Error(code, std::strerror(code), path.string());
+        }
+
+        /// Błąd, gdy plik wynikowy to plik wejściowy (obcięcie zmapowanego wejścia kończy się SIGBUS).
+        Option<Error> same_file_error(std::filesystem::path const& in, std::filesystem::path const& out) noexcept {
+            std::error_code ec{};
+            if (std::filesystem::equivalent(in, out, ec))
+                return Error(EINVAL, "input and output are the same file", out.string());
+            return {};
+        }
+
+        /// Deskryptor pliku zamykany automatycznie.
+        struct File {
+            int fd{-1};
+            File(File const&) = delete;
+            File& operator=(File const&) = delete;
+            explicit File(int const fd_) noexcept : fd{fd_} {}
+            ~File() {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+
+        /// Plik wynikowy, usuwany, jeśli nie udało się go poprawnie zapisać.
+        struct OutputFile : File {
+            std::filesystem::path path;
+            bool keep{};
+            explicit OutputFile(std::filesystem::path p) noexcept
+                : File{::open(p.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)}, path{std::move(p)} {}
+            ~OutputFile() {
+                if (fd >= 0 && !keep)
+                    ::unlink(path.c_str());
+            }
+        };
+
+        /// Obszar pliku zmapowany do pamięci.
+        struct Mapping {
+            void* addr{MAP_FAILED};
+            size_t size{};
+            Mapping(Mapping const&) = delete;
+            Mapping& operator=(Mapping const&) = delete;
+            Mapping(int const fd, size_t const size_, int const prot) noexcept : size{size_} {
+                if (size > 0)
+                    addr = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+            }
+            ~Mapping() {
+                if (addr != MAP_FAILED)
+                    ::munmap(addr, size);
+            }
+            [[nodiscard]] bool failed() const noexcept {
+                return size > 0 && addr == MAP_FAILED;
+            }
+            [[nodiscard]] Span<char> span() const noexcept {
+                return (addr == MAP_FAILED) ? Span<char>{} : Span<char>{static_cast<char*>(addr), size};
+            }
+        };
+
+        /// Zapis całego bufora do pliku (z obsługą częściowych zapisów i przerwań).
+        Option<Error> write_all(int const fd, Span<const char> data, std::filesystem::path const& path) noexcept {
+            while (!data.empty()) {
+                auto const n = ::write(fd, data.data(), data.size());
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    return system_error(path);
+                }
+                data = data.subspan(static_cast<size_t>(n));
+            }
+            return {};
+        }
+
+        /// Otwarcie pliku wejściowego i zmapowanie go w całości do odczytu sekwencyjnego.
+        Result<Pair<Unique<File>, Unique<Mapping>>, Error> map_input(std::filesystem::path const& path) noexcept {
+            auto file = std::make_unique<File>(::open(path.c_str(), O_RDONLY));
+            if (file->fd < 0)
+                return Failure(system_error(path));
+            struct stat st{};
+            if (::fstat(file->fd, &st) < 0)
+                return Failure(system_error(path));
+
+            auto mapping = std::make_unique<Mapping>(file->fd, static_cast<size_t>(st.st_size), PROT_READ);
+            if (mapping->failed())
+                return Failure(system_error(path));
+            if (mapping->size > 0)
+                ::madvise(mapping->addr, mapping->size, MADV_SEQUENTIAL);
+            return Pair{std::move(file), std::move(mapping)};
+        }
+
+        /// Nagłówek strumienia o podanym formacie (taki, jaki wygenerowałby sam zlib).
+        void put_header(Vector<char>& out, CompressOptions const& options) noexcept {
+            auto const level = (options.level == Z_DEFAULT_COMPRESSION) ? 6 : options.level;
+            switch (options.format) {
+                case Format::Gzip: {
+                    auto const xfl = (level == 9) ? 2 : (level == 1) ? 4 : 0;
+                    char const header[] = {'\x1f', '\x8b', Z_DEFLATED, 0, 0, 0, 0, 0, static_cast<char>(xfl), 3};
+                    out.insert(out.end(), std::begin(header), std::end(header));
+                    break;
+                }
+                case Format::Zlib: {
+                    auto const flevel = (options.strategy == Strategy::HuffmanOnly || options.strategy == Strategy::Rle || level < 2) ? 0
+                        : (level < 6) ? 1 : (level == 6) ? 2 : 3;
+                    auto header = static_cast<uint>((((window_bits(options) - 8) << 4) | Z_DEFLATED) << 8) | (flevel << 6);
+                    header += 31 - header % 31;
+                    out.push_back(static_cast<char>(header >> 8));
+                    out.push_back(static_cast<char>(header & 0xff));
+                    break;
+                }
+                case Format::Raw:
+                    break;
+            }
+        }
+    }
+
     /********************************************************************
     *                                                                   *
     *                        c o m p r e s s                            *
     *                                                                   *
     ********************************************************************/
 
-    Vector<char> compress(Span<const char> const plain) noexcept {
-        namespace bio = boost::iostreams;
-        std::vector<char> buffer{};
+    Result<Vector<char>, Error> compress(Span<const char> const plain) noexcept {
+        return compress(plain, CompressOptions::best());
+    }
 
-        bio::filtering_ostream in;
-        in.push(bio::gzip_compressor(bio::gzip::best_compression));
-        in.push(bio::back_inserter(buffer));
-        bio::write(in, plain.data(), static_cast<uint>(plain.size()));
-        in.flush();
+    Result<Vector<char>, Error> compress(Span<const char> const plain, CompressOptions const& options) noexcept {
+        return GzipContext::local().options(options).compress(plain);
+    }
 
-        buffer.shrink_to_fit();
-        return buffer;
+    Result<size_t, Error> compress_into(Span<const char> const plain, Span<char> const out, CompressOptions const& options) noexcept {
+        return GzipContext::local().options(options).compress_into(plain, out);
     }
 
     /********************************************************************
@@ -58,17 +334,811 @@ namespace bee {
     *                                                                   *
     ********************************************************************/
 
-    Vector<char> decompress(Span<const char> const compressed) noexcept {
-        namespace bio = boost::iostreams;
-        std::vector<char> buffer{};
+    Result<Vector<char>, Error> decompress(Span<const char> const compressed, DecompressOptions const& options) noexcept {
+        return GzipContext::local().decompress(compressed, options);
+    }
+
+    Result<size_t, Error> decompress_into(Span<const char> const compressed, Span<char> const out, DecompressOptions const& options) noexcept {
+        return GzipContext::local().decompress_into(compressed, out, options);
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *              c o m p r e s s _ p a r a l l e l                    *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<Vector<char>, Error> compress_parallel(Span<const char> const plain, CompressOptions const& options, size_t block_size, uint threads) noexcept {
+        auto const window_size = size_t{1} << window_bits(options);
+        block_size = std::clamp<size_t>(block_size, window_size, MaxAvail);
+        auto const count = std::max<size_t>(1, (plain.size() + block_size - 1) / block_size);
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<uint>(std::min<size_t>(threads, count));
+
+        // Suma kontrolna zależy od formatu: CRC32 dla gzip, Adler-32 dla zlib.
+        auto const checksum = [format = options.format](uLong const init, Span<const char> const data) {
+            auto const ptr = reinterpret_cast<Bytef const*>(data.data());
+            return (format == Format::Zlib) ? adler32_z(init, ptr, data.size()) : crc32_z(init, ptr, data.size());
+        };
+
+        struct Block {
+            Result<Vector<char>, Error> data{};
+            uLong check{};
+            size_t size{};
+        };
+        Vector<Block> blocks(count);
+        std::atomic<size_t> next{0};
+
+        // Każdy wątek pobiera kolejne numery bloków, aż do wyczerpania danych.
+        auto const worker = [&] {
+            RawDeflater deflater{options};
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                auto const offset = i * block_size;
+                auto const input = plain.subspan(offset, std::min(block_size, plain.size() - offset));
+                auto const dictionary = (i == 0) ? Span<const char>{} : plain.subspan(offset - window_size, window_size);
+                blocks[i].data = deflater.block(input, dictionary, i == count - 1);
+                blocks[i].check = checksum(checksum(0, {}), input);
+                blocks[i].size = input.size();
+            }
+        };
+
+        {
+            Vector<std::jthread> pool;
+            pool.reserve(threads);
+            for (uint i = 1; i < threads; ++i) {
+                // Jeśli system nie da więcej wątków, pracujemy tymi, które są.
+                try { pool.emplace_back(worker); }
+                catch (std::system_error const&) { break; }
+            }
+            worker();
+        }
+
+        // Sklejenie bloków w jeden strumień: nagłówek + bloki + stopka.
+        size_t size = 10 + 8;
+        for (auto const& block : blocks) {
+            if (!block.data)
+                return Failure(block.data.error());
+            size += block.data->size();
+        }
+
+        Vector<char> buffer{};
+        buffer.reserve(size);
+        put_header(buffer, options);
+
+        auto check = checksum(0, {});
+        for (auto const& block : blocks) {
+            auto const len = static_cast<z_off_t>(block.size);
+            check = (options.format == Format::Zlib) ? adler32_combine(check, block.check, len) : crc32_combine(check, block.check, len);
+            buffer.insert(buffer.end(), block.data->begin(), block.data->end());
+        }
+
+        switch (options.format) {
+            case Format::Gzip:
+                put_u32le(buffer, static_cast<u32>(check));
+                put_u32le(buffer, static_cast<u32>(plain.size()));
+                break;
+            case Format::Zlib:
+                put_u32be(buffer, static_cast<u32>(check));
+                break;
+            case Format::Raw:
+                break;
+        }
+        return buffer;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *            d e c o m p r e s s _ p a r a l l e l                  *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<Vector<char>, Error> decompress_parallel(Span<const char> const compressed, DecompressOptions const& options, uint threads) noexcept {
+        auto member_options = options;
+        member_options.format = Format::Gzip;
+        auto const serial = [&member_options](Span<const char> const input, size_t const limit) {
+            auto tail_options = member_options;
+            tail_options.max_output_size = limit;
+            return GzipContext::local().decompress(input, tail_options);
+        };
+
+        // Kandydaci na początki członów. Nagłówek: sygnatura, zerowe bity zarezerwowane,
+        // XFL (0, 2 lub 4) i znany system (0-13 lub 255). Dodatkowo stopka poprzedniego kandydata
+        // (ISIZE tuż przed nagłówkiem) musi być możliwa dla długości jego danych.
+        // Pozostałe fałszywe trafienia wychodzą przy dekompresji: człon musi skończyć się
+        // (z poprawnym CRC i ISIZE) dokładnie przed następnym nagłówkiem.
+        auto const is_header = [](Span<const char> const at) {
+            auto const flags = static_cast<u8>(at[3]);
+            auto const xfl = static_cast<u8>(at[8]);
+            auto const os = static_cast<u8>(at[9]);
+            return at[1] == '\x8b' && at[2] == Z_DEFLATED && (flags & 0xe0) == 0
+                && (xfl == 0 || xfl == 2 || xfl == 4) && (os <= 13 || os == 255);
+        };
+        Vector<size_t> starts{};
+        for (size_t pos = 0; pos + 18 <= compressed.size();) {
+            auto const found = static_cast<char const*>(std::memchr(compressed.data() + pos, 0x1f, compressed.size() - 18 - pos + 1));
+            if (!found)
+                break;
+            pos = static_cast<size_t>(found - compressed.data());
+            if (is_header(compressed.subspan(pos))) {
+                if (starts.empty())
+                    starts.push_back(pos);
+                else if (auto const prev = starts.back(); pos - prev >= 18) {
+                    auto const isize = *decompressed_size(compressed.subspan(prev, pos - prev));
+                    if (isize <= (pos - prev) * 1032)
+                        starts.push_back(pos);
+                }
+            }
+            ++pos;
+        }
+        if (starts.size() < 2 || starts.front() != 0)
+            return serial(compressed, options.max_output_size);
+
+        auto const count = starts.size();
+        auto const range = [&](size_t const first, size_t const last) {
+            auto const end = (last + 1 < count) ? starts[last + 1] : compressed.size();
+            return compressed.subspan(starts[first], end - starts[first]);
+        };
+
+        // Rozmiary członów ze stopek (ISIZE) wyznaczają fragmenty bufora wynikowego.
+        struct Member {
+            size_t offset{};
+            size_t size{};
+            Result<size_t, Error> produced{};
+        };
+        Vector<Member> members(count);
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            members[i].offset = total;
+            members[i].size = *decompressed_size(range(i, i));
+            total += members[i].size;
+        }
+        // Suma ze stopek ponad limit: nie przydzielamy pamięci na zapas, dekompresja sekwencyjna
+        // odrzuci dane, gdy tylko faktyczny wynik przekroczy limit (a fałszywy kandydat nie zablokuje poprawnych danych).
+        if (total > options.max_output_size)
+            return serial(compressed, options.max_output_size);
+
+        Vector<char> buffer{};
+        try {
+            buffer.resize(total);
+        } catch (std::bad_alloc const&) {
+            return Failure(memory_error());
+        }
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<uint>(std::min<size_t>(threads, count));
+
+        // Każdy człon dekompresowany jest w osobnym wątku wprost do swojego fragmentu bufora;
+        // fragment ogranicza też rozmiar wyniku członu.
+        std::atomic<size_t> next{0};
+        auto const worker = [&] {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                auto& member = members[i];
+                auto const out = Span<char>{buffer}.subspan(member.offset, member.size);
+                member.produced = GzipContext::local().decompress_into(range(i, i), out, member_options);
+            }
+        };
+
+        {
+            Vector<std::jthread> pool;
+            pool.reserve(threads);
+            for (uint i = 1; i < threads; ++i) {
+                try { pool.emplace_back(worker); }
+                catch (std::system_error const&) { break; }
+            }
+            worker();
+        }
+
+        // Człon, którego faktyczny rozmiar nie zgadza się ze stopką (lub który się nie zdekompresował),
+        // kończy się zwykle za fałszywym kandydatem: łączymy go z następnym i ponawiamy tylko
+        // ten fragment (w miejscu obu fragmentów). Jeśli i to zawiedzie, resztę danych od tego
+        // członu dekompresujemy sekwencyjnie. Wyniki dosuwamy do siebie, gdy powstały luki.
+        size_t written = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto produced = members[i].produced;
+            auto merged = false;
+            if ((!produced || *produced != members[i].size) && i + 1 < count) {
+                auto const out = Span<char>{buffer}.subspan(members[i].offset, members[i].size + members[i + 1].size);
+                produced = GzipContext::local().decompress_into(range(i, i + 1), out, member_options);
+                merged = produced.has_value();
+            }
+            if (!produced || (!merged && *produced != members[i].size)) {
+                if (i + 1 == count && !produced)
+                    return Failure(produced.error());
+                auto tail = serial(compressed.subspan(starts[i]), options.max_output_size - written);
+                if (!tail)
+                    return Failure(tail.error());
+                try {
+                    buffer.resize(written);
+                    buffer.insert(buffer.end(), tail->begin(), tail->end());
+                } catch (std::bad_alloc const&) {
+                    return Failure(memory_error());
+                }
+                return buffer;
+            }
+            if (members[i].offset != written)
+                std::memmove(buffer.data() + written, buffer.data() + members[i].offset, *produced);
+            written += *produced;
+            if (merged)
+                ++i;
+        }
+        buffer.resize(written);
+        return buffer;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                      G z i p E n c o d e r                        *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<GzipEncoder, Error> GzipEncoder::create(CompressOptions const& options, Sink sink, size_t const chunk_size) noexcept {
+        auto strm = std::make_unique<z_stream>();
+        auto const ret = deflateInit2(strm.get(), options.level, Z_DEFLATED, deflate_window_bits(options),
+                                      options.mem_level, zlib_strategy(options.strategy));
+        if (ret != Z_OK)
+            return Failure(zlib_error(ret, strm.get()));
+        return GzipEncoder(std::move(strm), std::move(sink), chunk_size);
+    }
+
+    GzipEncoder::GzipEncoder(Unique<z_stream_s> strm, Sink sink, size_t const chunk_size) noexcept
+        : strm_{std::move(strm)}, sink_{std::move(sink)}
+    {
+        // Bufor pośredni jest potrzebny tylko wtedy, gdy dane oddajemy odbiorcy.
+        if (sink_)
+            chunk_.resize(std::clamp<size_t>(chunk_size, 1, MaxAvail));
+    }
+
+    GzipEncoder::GzipEncoder(GzipEncoder&& other) noexcept = default;
+
+    GzipEncoder& GzipEncoder::operator=(GzipEncoder&& other) noexcept {
+        if (this != &other) {
+            if (strm_)
+                deflateEnd(strm_.get());
+            strm_ = std::move(other.strm_);
+            sink_ = std::move(other.sink_);
+            chunk_ = std::move(other.chunk_);
+            finished_ = other.finished_;
+        }
+        return *this;
+    }
+
+    GzipEncoder::~GzipEncoder() {
+        if (strm_)
+            deflateEnd(strm_.get());
+    }
+
+    Result<Unit, Error> GzipEncoder::write(Span<const char> const input) noexcept {
+        return drain(input, Z_NO_FLUSH);
+    }
+
+    Result<Unit, Error> GzipEncoder::finish() noexcept {
+        return drain({}, Z_FINISH);
+    }
+
+    Result<Progress, Error> GzipEncoder::process(Span<const char> const input, Span<char> const output, bool const finish) noexcept {
+        if (finished_)
+            return Progress{.done = true};
+
+        auto const in = input.first(std::min(input.size(), MaxAvail));
+        auto const out = output.first(std::min(output.size(), MaxAvail));
+        char dummy{};
+        strm_->next_in = in_ptr(in.data());
+        strm_->avail_in = static_cast<uInt>(in.size());
+        strm_->next_out = out.empty() ? out_ptr(&dummy) : out_ptr(out.data());
+        strm_->avail_out = static_cast<uInt>(out.size());
+
+        // Z_FINISH tylko wtedy, gdy cała ostatnia porcja zmieściła się w jednym wywołaniu.
+        auto const flush = (finish && in.size() == input.size()) ? Z_FINISH : Z_NO_FLUSH;
+        auto const ret = deflate(strm_.get(), flush);
+        if (ret == Z_STREAM_ERROR)
+            return Failure(zlib_error(ret, strm_.get()));
+        if (ret == Z_STREAM_END)
+            finished_ = true;
+
+        return Progress{
+            .consumed = in.size() - strm_->avail_in,
+            .produced = out.size() - strm_->avail_out,
+            .done = finished_
+        };
+    }
+
+    Result<Unit, Error> GzipEncoder::reset() noexcept {
+        if (auto const ret = deflateReset(strm_.get()); ret != Z_OK)
+            return Failure(zlib_error(ret, strm_.get()));
+        finished_ = false;
+        return Success;
+    }
+
+    size_t GzipEncoder::bound(size_t const size) const noexcept {
+        return deflateBound(strm_.get(), size);
+    }
+
+    Result<Unit, Error> GzipEncoder::dictionary(Span<const char> const data) noexcept {
+        auto const size = std::min(data.size(), MaxAvail);
+        if (auto const ret = deflateSetDictionary(strm_.get(), in_ptr(data.data()), static_cast<uInt>(size)); ret != Z_OK)
+            return Failure(zlib_error(ret, strm_.get()));
+        return Success;
+    }
 
-        bio::filtering_ostream in;
-        in.push(bio::gzip_decompressor());
-        in.push(bio::back_inserter(buffer));
-        bio::write(in, compressed.data(), static_cast<uint>(compressed.size()));
-        in.flush();
+    Result<Unit, Error> GzipEncoder::drain(Span<const char> input, int const flush) noexcept {
+        if (!sink_)
+            return Failure(Error(Z_STREAM_ERROR, "no output sink"));
+        if (finished_)
+            return Failure(Error(Z_STREAM_ERROR, "stream already finished"));
 
+        do {
+            auto const part = input.first(std::min(input.size(), MaxAvail));
+            input = input.subspan(part.size());
+            strm_->next_in = in_ptr(part.data());
+            strm_->avail_in = static_cast<uInt>(part.size());
+
+            // Flagę zakończenia przekazujemy dopiero z ostatnią częścią danych.
+            auto const mode = input.empty() ? flush : Z_NO_FLUSH;
+            int ret{};
+            do {
+                strm_->next_out = out_ptr(chunk_.data());
+                strm_->avail_out = static_cast<uInt>(chunk_.size());
+                ret = deflate(strm_.get(), mode);
+                if (ret == Z_STREAM_ERROR)
+                    return Failure(zlib_error(ret, strm_.get()));
+                if (auto const n = chunk_.size() - strm_->avail_out)
+                    sink_(Span<const char>{chunk_.data(), n});
+            } while (strm_->avail_out == 0);
+
+            if (ret == Z_STREAM_END)
+                finished_ = true;
+        } while (!input.empty());
+
+        return Success;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                      G z i p D e c o d e r                        *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<GzipDecoder, Error> GzipDecoder::create(Sink sink, size_t const chunk_size, Format const format) noexcept {
+        auto strm = std::make_unique<z_stream>();
+        if (auto const ret = inflateInit2(strm.get(), inflate_window_bits(format)); ret != Z_OK)
+            return Failure(zlib_error(ret, strm.get()));
+        return GzipDecoder(std::move(strm), std::move(sink), chunk_size);
+    }
+
+    GzipDecoder::GzipDecoder(Unique<z_stream_s> strm, Sink sink, size_t const chunk_size) noexcept
+        : strm_{std::move(strm)}, sink_{std::move(sink)}
+    {
+        if (sink_)
+            chunk_.resize(std::clamp<size_t>(chunk_size, 1, MaxAvail));
+    }
+
+    GzipDecoder::GzipDecoder(GzipDecoder&& other) noexcept = default;
+
+    GzipDecoder& GzipDecoder::operator=(GzipDecoder&& other) noexcept {
+        if (this != &other) {
+            if (strm_)
+                inflateEnd(strm_.get());
+            strm_ = std::move(other.strm_);
+            sink_ = std::move(other.sink_);
+            chunk_ = std::move(other.chunk_);
+            limit_ = other.limit_;
+            produced_ = other.produced_;
+            ended_ = other.ended_;
+        }
+        return *this;
+    }
+
+    GzipDecoder::~GzipDecoder() {
+        if (strm_)
+            inflateEnd(strm_.get());
+    }
+
+    Result<Unit, Error> GzipDecoder::write(Span<const char> input) noexcept {
+        if (!sink_)
+            return Failure(Error(Z_STREAM_ERROR, "no output sink"));
+
+        while (!input.empty()) {
+            auto const part = input.first(std::min(input.size(), MaxAvail));
+            input = input.subspan(part.size());
+            strm_->next_in = in_ptr(part.data());
+            strm_->avail_in = static_cast<uInt>(part.size());
+
+            do {
+                // Po zakończeniu członu gzip kolejne bajty rozpoczynają następny człon.
+                if (ended_) {
+                    if (strm_->avail_in == 0)
+                        break;
+                    if (auto const ret = inflateReset(strm_.get()); ret != Z_OK)
+                        return Failure(zlib_error(ret, strm_.get()));
+                    ended_ = false;
+                }
+
+                strm_->next_out = out_ptr(chunk_.data());
+                strm_->avail_out = static_cast<uInt>(chunk_.size());
+                auto const ret = inflate(strm_.get(), Z_NO_FLUSH);
+                if (ret == Z_NEED_DICT) {
+                    if (auto const ok = use_dictionary(); !ok)
+                        return Failure(ok.error());
+                    continue;
+                }
+                if (ret == Z_STREAM_END)
+                    ended_ = true;
+                else if (ret != Z_OK && ret != Z_BUF_ERROR)
+                    return Failure(zlib_error(ret, strm_.get()));
+
+                auto const n = chunk_.size() - strm_->avail_out;
+                if (n > limit_ - produced_)
+                    return Failure(limit_error());
+                produced_ += n;
+                if (n)
+                    sink_(Span<const char>{chunk_.data(), n});
+                else if (ret == Z_BUF_ERROR)
+                    break;
+            } while (strm_->avail_in > 0 || strm_->avail_out == 0);
+        }
+        return Success;
+    }
+
+    Result<Unit, Error> GzipDecoder::finish() const noexcept {
+        if (!ended_)
+            return Failure(Error(Z_BUF_ERROR, "unexpected end of compressed stream"));
+        return Success;
+    }
+
+    Result<Progress, Error> GzipDecoder::process(Span<const char> const input, Span<char> const output) noexcept {
+        // Bufor wyjściowy przycinamy do tego, co jeszcze mieści się w limicie.
+        auto const allowed = limit_ - produced_;
+        auto const capped = output.size() > allowed;
+        auto const in = input.first(std::min(input.size(), MaxAvail));
+        auto const out = output.first(std::min({output.size(), allowed, MaxAvail}));
+        // Nawet bez miejsca na wynik zlib musi dostać poprawny wskaźnik, żeby przetworzyć
+        // nagłówek lub stopkę (np. pusty człon gzip).
+        char dummy{};
+        strm_->next_in = in_ptr(in.data());
+        strm_->avail_in = static_cast<uInt>(in.size());
+        strm_->next_out = out.empty() ? out_ptr(&dummy) : out_ptr(out.data());
+        strm_->avail_out = static_cast<uInt>(out.size());
+
+        for (;;) {
+            if (ended_) {
+                if (strm_->avail_in == 0)
+                    break;
+                if (auto const ret = inflateReset(strm_.get()); ret != Z_OK)
+                    return Failure(zlib_error(ret, strm_.get()));
+                ended_ = false;
+            }
+
+            auto const ret = inflate(strm_.get(), Z_NO_FLUSH);
+            if (ret == Z_NEED_DICT) {
+                if (auto const ok = use_dictionary(); !ok)
+                    return Failure(ok.error());
+                continue;
+            }
+            if (ret == Z_STREAM_END) {
+                ended_ = true;
+                continue;
+            }
+            if (ret != Z_OK && ret != Z_BUF_ERROR)
+                return Failure(zlib_error(ret, strm_.get()));
+            break;
+        }
+
+        // Brak miejsca przy nieprzetworzonym wejściu oznacza, że dane przekraczają limit.
+        if (capped && !ended_ && strm_->avail_out == 0 && strm_->avail_in > 0)
+            return Failure(limit_error());
+
+        auto const consumed = in.size() - strm_->avail_in;
+        auto const produced = out.size() - strm_->avail_out;
+        produced_ += produced;
+        return Progress{
+            .consumed = consumed,
+            .produced = produced,
+            .done = ended_ && consumed == input.size()
+        };
+    }
+
+    Result<Unit, Error> GzipDecoder::reset() noexcept {
+        if (auto const ret = inflateReset(strm_.get()); ret != Z_OK)
+            return Failure(zlib_error(ret, strm_.get()));
+        produced_ = 0;
+        ended_ = false;
+        return Success;
+    }
+
+    Result<Unit, Error> GzipDecoder::verify(bool const check) noexcept {
+        if (auto const ret = inflateValidate(strm_.get(), check ? 1 : 0); ret != Z_OK)
+            return Failure(zlib_error(ret, strm_.get()));
+        return Success;
+    }
+
+    Result<Unit, Error> GzipDecoder::use_dictionary() noexcept {
+        if (dictionary_.empty())
+            return Failure(zlib_error(Z_NEED_DICT));
+        // zlib porównuje Adler-32 słownika z identyfikatorem zapisanym w nagłówku strumienia.
+        if (auto const ret = inflateSetDictionary(strm_.get(), in_ptr(dictionary_.data()), static_cast<uInt>(dictionary_.size())); ret != Z_OK)
+            return Failure(Error(ret, "dictionary mismatch"));
+        return Success;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                      G z i p C o n t e x t                        *
+    *                                                                   *
+    ********************************************************************/
+
+    GzipContext& GzipContext::local() noexcept {
+        thread_local GzipContext context{};
+        return context;
+    }
+
+    Result<Vector<char>, Error> GzipContext::compress(Span<const char> const plain) noexcept {
+        Vector<char> buffer(compress_bound(plain.size(), options_.format));
+        auto const size = compress_into(plain, buffer);
+        if (!size)
+            return Failure(size.error());
+
+        // Wynik jest zwykle dużo mniejszy od górnego ograniczenia, nie trzymamy nadmiaru pamięci.
+        buffer.resize(*size);
         buffer.shrink_to_fit();
         return buffer;
     }
+
+    Result<size_t, Error> GzipContext::compress_into(Span<const char> plain, Span<char> const out) noexcept {
+        auto const encoder = this->encoder();
+        if (!encoder)
+            return Failure(encoder.error());
+
+        size_t size = 0;
+        for (;;) {
+            auto const progress = (*encoder)->process(plain, out.subspan(size), true);
+            if (!progress)
+                return Failure(progress.error());
+            plain = plain.subspan(progress->consumed);
+            size += progress->produced;
+            if (progress->done)
+                return size;
+            if (size == out.size())
+                return Failure(Error(Z_BUF_ERROR, "output buffer too small"));
+        }
+    }
+
+    Result<Vector<char>, Error> GzipContext::decompress(Span<const char> const compressed, DecompressOptions const& options) noexcept {
+        auto const decoder = this->decoder(options);
+        if (!decoder)
+            return Failure(decoder.error());
+
+        // Rozmiar ze stopki gzip pochodzi z danych wejściowych, więc to tylko podpowiedź:
+        // ograniczamy ją maksymalnym współczynnikiem kompresji deflate (ok. 1032:1),
+        // limitem i rozmiarem pierwszego przydziału (dalej bufor rośnie w miarę potrzeby).
+        auto size = compressed.size() * 4;
+        if (options.format == Format::Gzip)
+            if (auto const hint = decompressed_size(compressed))
+                size = std::min(*hint, compressed.size() * 1032);
+        size = std::min({size, options.max_output_size, MaxPresize});
+
+        try {
+            Vector<char> buffer(size);
+            auto const n = inflate_into(**decoder, compressed, buffer, options.max_output_size);
+            if (!n)
+                return Failure(n.error());
+            buffer.resize(*n);
+            return buffer;
+        } catch (std::bad_alloc const&) {
+            return Failure(memory_error());
+        }
+    }
+
+    Result<size_t, Error> GzipContext::decompress_into(Span<const char> compressed, Span<char> const out, DecompressOptions const& options) noexcept {
+        auto const decoder = this->decoder(options);
+        if (!decoder)
+            return Failure(decoder.error());
+
+        size_t size = 0;
+        for (;;) {
+            auto const progress = (*decoder)->process(compressed, out.subspan(size));
+            if (!progress)
+                return Failure(progress.error());
+            compressed = compressed.subspan(progress->consumed);
+            size += progress->produced;
+            if (progress->done)
+                return size;
+            if (size == out.size())
+                return Failure(Error(Z_BUF_ERROR, "output buffer too small"));
+            if (compressed.empty())
+                return Failure(Error(Z_BUF_ERROR, "unexpected end of compressed stream"));
+        }
+    }
+
+    Result<GzipEncoder*, Error> GzipContext::encoder() noexcept {
+        auto const it = std::ranges::find(encoders_, options_, &CachedEncoder::options);
+        if (it != encoders_.end()) {
+            // Użyty kompresor przesuwamy na koniec (najdawniej używany jest na początku).
+            std::rotate(it, it + 1, encoders_.end());
+            if (auto const ok = encoders_.back().encoder.reset(); !ok)
+                return Failure(ok.error());
+        } else {
+            auto created = GzipEncoder::create(options_);
+            if (!created)
+                return Failure(created.error());
+            if (encoders_.size() == EncoderCacheSize)
+                encoders_.erase(encoders_.begin());
+            encoders_.push_back({options_, std::move(*created)});
+        }
+
+        // Słownik trzeba ustawiać na nowo po każdym deflateReset.
+        auto& encoder = encoders_.back().encoder;
+        if (!dictionary_.empty())
+            if (auto const ok = encoder.dictionary(dictionary_); !ok)
+                return Failure(ok.error());
+        return &encoder;
+    }
+
+    Result<GzipDecoder*, Error> GzipContext::decoder(DecompressOptions const& options) noexcept {
+        auto const format = options.format;
+        // Gzip i zlib obsługuje ten sam dekompresor, dane bez ramki wymagają innego.
+        if (decoder_ && (decoder_format_ == Format::Raw) == (format == Format::Raw)) {
+            if (auto const ok = decoder_->reset(); !ok)
+                return Failure(ok.error());
+        } else {
+            auto created = GzipDecoder::create({}, GzipDecoder::DefaultChunkSize, format);
+            if (!created)
+                return Failure(created.error());
+            decoder_ = std::move(*created);
+            decoder_format_ = format;
+        }
+
+        // Ustawienie sprawdzania sumy kontrolnej przetrwa inflateReset, więc odnawiamy je za każdym razem.
+        if (auto const ok = decoder_->verify(options.verify_checksum); !ok)
+            return Failure(ok.error());
+        decoder_->limit(options.max_output_size);
+        decoder_->dictionary(dictionary_);
+        return &*decoder_;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                   c o m p r e s s _ m a n y                       *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<Vector<Vector<char>>, Error> compress_many(Span<const Span<const char>> const inputs, CompressOptions const& options) noexcept {
+        auto& context = GzipContext::local().options(options);
+
+        // Jeden bufor roboczy, wystarczający dla największego komunikatu.
+        size_t max_size = 0;
+        for (auto const input : inputs)
+            max_size = std::max(max_size, input.size());
+        Vector<char> scratch(compress_bound(max_size, options.format));
+
+        Vector<Vector<char>> result;
+        result.reserve(inputs.size());
+        for (auto const input : inputs) {
+            auto const size = context.compress_into(input, scratch);
+            if (!size)
+                return Failure(size.error());
+            result.emplace_back(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(*size));
+        }
+        return result;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                    c o m p r e s s _ f i l e                      *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<size_t, Error> compress_file(std::filesystem::path const& path_in, std::filesystem::path const& path_out, CompressOptions const& options) noexcept {
+        if (auto const err = same_file_error(path_in, path_out))
+            return Failure(*err);
+        auto const input = map_input(path_in);
+        if (!input)
+            return Failure(input.error());
+
+        OutputFile out{path_out};
+        if (out.fd < 0)
+            return Failure(system_error(path_out));
+
+        // Odbiorca nie może zwrócić błędu, więc zapamiętujemy pierwszy i pomijamy dalsze zapisy.
+        Option<Error> failure{};
+        size_t written = 0;
+        auto encoder = GzipEncoder::create(options, [&](Span<const char> const data) {
+            if (failure)
+                return;
+            failure = write_all(out.fd, data, path_out);
+            written += data.size();
+        }, FileChunkSize);
+        if (!encoder)
+            return Failure(encoder.error());
+
+        if (auto const ok = encoder->write(input->second->span()); !ok)
+            return Failure(ok.error());
+        if (auto const ok = encoder->finish(); !ok)
+            return Failure(ok.error());
+        if (failure)
+            return Failure(*failure);
+
+        out.keep = true;
+        return written;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                  d e c o m p r e s s _ f i l e                    *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<size_t, Error> decompress_file(std::filesystem::path const& path_in, std::filesystem::path const& path_out, DecompressOptions const& options) noexcept {
+        if (auto const err = same_file_error(path_in, path_out))
+            return Failure(*err);
+        auto const format = options.format;
+        auto const input = map_input(path_in);
+        if (!input)
+            return Failure(input.error());
+        Span<const char> compressed = input->second->span();
+
+        OutputFile out{path_out};
+        if (out.fd < 0)
+            return Failure(system_error(path_out));
+
+        Option<Error> failure{};
+        size_t written = 0;
+        auto decoder = GzipDecoder::create([&](Span<const char> const data) {
+            if (failure)
+                return;
+            failure = write_all(out.fd, data, path_out);
+            written += data.size();
+        }, FileChunkSize, format);
+        if (!decoder)
+            return Failure(decoder.error());
+        if (auto const ok = decoder->verify(options.verify_checksum); !ok)
+            return Failure(ok.error());
+        decoder->limit(options.max_output_size);
+
+        // Etap 1: rozmiar ze stopki gzip - plik wynikowy zapisywany bezpośrednio przez mmap.
+        // Rozmiar ze stopki ograniczamy maksymalnym współczynnikiem kompresji deflate.
+        auto done = false;
+        if (auto const hint = (format == Format::Gzip) ? decompressed_size(compressed) : Option<size_t>{}; hint && *hint > 0) {
+            auto const size = std::min({*hint, compressed.size() * 1032, options.max_output_size});
+            if (::ftruncate(out.fd, static_cast<off_t>(size)) < 0)
+                return Failure(system_error(path_out));
+            Mapping const mapping{out.fd, size, PROT_READ | PROT_WRITE};
+            if (mapping.failed())
+                return Failure(system_error(path_out));
+            ::madvise(mapping.addr, mapping.size, MADV_SEQUENTIAL);
+
+            auto const target = mapping.span();
+            while (!done && written < target.size()) {
+                auto const progress = decoder->process(compressed, target.subspan(written));
+                if (!progress)
+                    return Failure(progress.error());
+                compressed = compressed.subspan(progress->consumed);
+                written += progress->produced;
+                done = progress->done;
+                if (!done && compressed.empty() && written < target.size())
+                    return Failure(Error(Z_BUF_ERROR, "unexpected end of compressed stream"));
+            }
+            // Dalsze dane (np. kolejne człony gzip) dopisywane są za zmapowanym obszarem.
+            if (::lseek(out.fd, static_cast<off_t>(written), SEEK_SET) < 0)
+                return Failure(system_error(path_out));
+        }
+
+        // Etap 2: pozostałe dane zapisywane porcjami.
+        if (!done) {
+            if (auto const ok = decoder->write(compressed); !ok)
+                return Failure(ok.error());
+            if (auto const ok = decoder->finish(); !ok)
+                return Failure(ok.error());
+            if (failure)
+                return Failure(*failure);
+        }
+
+        // Stopka mogła podać więcej niż faktycznie zdekompresowano.
+        if (::ftruncate(out.fd, static_cast<off_t>(written)) < 0)
+            return Failure(system_error(path_out));
+
+        out.keep = true;
+        return written;
+    }
 }
@@ -28,15 +28,401 @@
 /*------- include files:
 -------------------------------------------------------------------*/
 #include "types.h"
+#include "error.h"
+#include <functional>
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <limits>
+
+// Stan strumienia zlib (zlib.h dołączamy tylko w gzip.cpp).
+struct z_stream_s;
 
 namespace bee {
-    /// Kompresja bajtów.
+    /// Format ramki skompresowanych danych.
+    enum class Format {
+        Gzip,   // nagłówek i stopka gzip (CRC32)
+        Zlib,   // nagłówek i stopka zlib (Adler-32)
+        Raw     // sam strumień deflate, bez nagłówka i stopki
+    };
+
+    /// Strategia kompresji deflate (odpowiada stałym Z_*_STRATEGY).
+    enum class Strategy {
+        Default,        // zwykłe dane
+        Filtered,       // dane o małych, losowo rozłożonych wartościach
+        Rle,            // tylko powtórzenia (szybka, dobra dla np. obrazów)
+        HuffmanOnly     // tylko kodowanie Huffmana, bez wyszukiwania powtórzeń
+    };
+
+    /// Parametry kompresji.
+    /// Domyślny poziom to 6 (jak w zlib). Dotychczasowe wywołania bez parametrów
+    /// (compress(plain), GzipEncoder::create(sink)) zachowują poziom 9 - patrz best().
+    struct CompressOptions {
+        int level{6};           // 0 (bez kompresji) - 9 (najlepsza)
+        int window_bits{15};    // 9 - 15, rozmiar okna to 2^window_bits
+        int mem_level{8};       // 1 - 9, pamięć na stan wewnętrzny kompresora
+        Strategy strategy{Strategy::Default};
+        Format format{Format::Gzip};
+
+        /// Najszybsza kompresja (dla ruchu, w którym liczy się opóźnienie).
+        static constexpr CompressOptions fast() noexcept { return {.level = 1}; }
+        /// Najlepsza kompresja (dotychczasowe zachowanie compress).
+        static constexpr CompressOptions best() noexcept { return {.level = 9}; }
+        /// Parametry dobrane do rozmiaru danych.
+        /// Małe dane kompresują się szybko na każdym poziomie, więc dostają lepszy poziom
+        /// i okno nie większe niż same dane. Duże dane dostają szybszy poziom.
+        static constexpr CompressOptions adaptive(size_t const size) noexcept {
+            CompressOptions options{};
+            options.level = (size <= 16 * 1024) ? 6 : (size <= 1024 * 1024) ? 4 : 1;
+            options.window_bits = std::clamp(static_cast<int>(std::bit_width(size)), 9, 15);
+            return options;
+        }
+
+        bool operator==(CompressOptions const&) const noexcept = default;
+    };
+
+    /// Parametry dekompresji.
+    struct DecompressOptions {
+        Format format{Format::Gzip};    // gzip i zlib rozpoznawane są automatycznie
+        /// Maksymalny rozmiar danych po dekompresji (ochrona przed "bombami" dekompresyjnymi).
+        size_t max_output_size{std::numeric_limits<size_t>::max()};
+        /// Czy liczyć i sprawdzać sumę kontrolną (CRC32/Adler-32).
+        /// Wyłączenie przyspiesza dekompresję zaufanych danych (np. wewnętrznych).
+        bool verify_checksum{true};
+    };
+
+    /// Górne ograniczenie rozmiaru wyniku kompresji (niezależne od poziomu i strategii).
+    /// \param size Rozmiar danych do kompresji,
+    /// \param format Format ramki danych.
+    /// \return Rozmiar bufora, który na pewno pomieści skompresowane dane.
+    constexpr size_t compress_bound(size_t const size, Format const format = Format::Gzip) noexcept {
+        auto const wrapper = (format == Format::Gzip) ? 18 : (format == Format::Zlib) ? 6 : 0;
+        return size + ((size + 7) >> 3) + ((size + 63) >> 6) + 7 + wrapper;
+    }
+
+    /// Rozmiar danych po dekompresji zapisany w stopce gzip (pole ISIZE).
+    /// Pole przechowuje rozmiar modulo 2^32 i dotyczy tylko ostatniego członu,
+    /// więc wynik należy traktować jako podpowiedź, a nie gwarancję.
+    /// \param compressed Dane w formacie gzip.
+    /// \return Rozmiar z ISIZE lub nic, jeśli to nie są dane gzip.
+    constexpr Option<size_t> decompressed_size(Span<const char> const compressed) noexcept {
+        if (compressed.size() < 18 || compressed[0] != '\x1f' || compressed[1] != '\x8b')
+            return {};
+        auto const tail = compressed.last(4);
+        u32 size{};
+        for (auto i = 3; i >= 0; --i)
+            size = (size << 8) | static_cast<u8>(tail[i]);
+        return size;
+    }
+
+    // Wszystkie funkcje zwracają błędy jako Error z kodem zlib (np. Z_DATA_ERROR
+    // dla uszkodzonych danych, Z_BUF_ERROR dla obciętych danych lub za małego bufora).
+
+    /// Kompresja bajtów (najlepsza kompresja, format gzip).
     /// \param plain Ciąg bajtów, który ma być kompresowany.
-    /// \return Wektor bajtów po kompresji.
-    extern Vector<char> compress(Span<const char> plain) noexcept;
+    /// \return Wektor bajtów po kompresji lub błąd.
+    extern Result<Vector<char>, Error> compress(Span<const char> plain) noexcept;
+
+    /// Kompresja bajtów z podanymi parametrami.
+    /// \param plain Ciąg bajtów, który ma być kompresowany,
+    /// \param options Parametry kompresji.
+    /// \return Wektor bajtów po kompresji lub błąd.
+    extern Result<Vector<char>, Error> compress(Span<const char> plain, CompressOptions const& options) noexcept;
+
+    /// Kompresja bajtów do bufora dostarczonego przez wołającego.
+    /// Używa kontekstu bieżącego wątku (GzipContext::local()), więc przy
+    /// powtarzanych wywołaniach z tymi samymi parametrami nie alokuje pamięci.
+    /// \param plain Ciąg bajtów, który ma być kompresowany,
+    /// \param out Bufor na wynik (rozmiar compress_bound() zawsze wystarcza),
+    /// \param options Parametry kompresji.
+    /// \return Liczba bajtów zapisanych do bufora lub błąd (np. za mały bufor).
+    extern Result<size_t, Error> compress_into(Span<const char> plain, Span<char> out, CompressOptions const& options = {}) noexcept;
 
     /// Dekompresja bajtów.
-    /// \param compressed Ciąg bajtów, który ma być dekompresowany.
-    /// \return Wektor bajtów po dekompresji.
-    extern Vector<char> decompress(Span<const char> compressed) noexcept;
+    /// Formaty gzip i zlib rozpoznawane są automatycznie, format Raw trzeba wskazać.
+    /// Bufor wynikowy jest alokowany od razu w rozmiarze odczytanym ze stopki gzip.
+    /// \param compressed Ciąg bajtów, który ma być dekompresowany,
+    /// \param options Parametry dekompresji (format, limit rozmiaru, sprawdzanie sumy kontrolnej).
+    /// \return Wektor bajtów po dekompresji lub błąd.
+    extern Result<Vector<char>, Error> decompress(Span<const char> compressed, DecompressOptions const& options = {}) noexcept;
+
+    /// Dekompresja bajtów do bufora dostarczonego przez wołającego.
+    /// Używa kontekstu bieżącego wątku (GzipContext::local()), więc nie alokuje pamięci.
+    /// \param compressed Ciąg bajtów, który ma być dekompresowany,
+    /// \param out Bufor na wynik (np. o rozmiarze z decompressed_size()),
+    /// \param options Parametry dekompresji.
+    /// \return Liczba bajtów zapisanych do bufora lub błąd (np. za mały bufor).
+    extern Result<size_t, Error> decompress_into(Span<const char> compressed, Span<char> out, DecompressOptions const& options = {}) noexcept;
+
+    /// Domyślny rozmiar bloku kompresji równoległej.
+    static constexpr size_t ParallelBlockSize = 1024 * 1024;
+
+    /// Równoległa kompresja bajtów (w stylu pigz).
+    /// Dane dzielone są na bloki kompresowane niezależnie w wielu wątkach,
+    /// każdy blok dostaje jako słownik końcówkę (rozmiar okna) poprzedniego bloku.
+    /// Wynikiem jest jeden standardowy strumień (zgodny z gunzip i decompress).
+    /// \param plain Ciąg bajtów, który ma być kompresowany,
+    /// \param options Parametry kompresji,
+    /// \param block_size Rozmiar pojedynczego bloku (co najmniej 32KB),
+    /// \param threads Liczba wątków (0 - liczba rdzeni procesora).
+    /// \return Wektor bajtów po kompresji lub błąd.
+    extern Result<Vector<char>, Error> compress_parallel(Span<const char> plain, CompressOptions const& options, size_t block_size = ParallelBlockSize, uint threads = 0) noexcept;
+
+    /// Równoległa kompresja bajtów (najlepsza kompresja, format gzip).
+    inline Result<Vector<char>, Error> compress_parallel(Span<const char> const plain, size_t const block_size = ParallelBlockSize, uint const threads = 0) noexcept {
+        return compress_parallel(plain, CompressOptions::best(), block_size, threads);
+    }
+
+    /// Równoległa dekompresja strumienia złożonego z wielu członów gzip
+    /// (np. sklejone archiwa lub wynik równoległych kompresorów).
+    /// Granice członów wyznaczane są z nagłówków (i zgodnych z nimi stopek), rozmiary ze stopek (ISIZE),
+    /// a każdy człon dekompresowany jest w osobnym wątku wprost do swojego fragmentu bufora wynikowego.
+    /// Człon, którego faktyczny rozmiar nie zgadza się ze stopką, jest łączony z następnym
+    /// i dekompresowany ponownie (bez powtarzania reszty pracy).
+    /// Dane z jednym członem (lub o sumie rozmiarów ze stopek ponad limit) dekompresowane są sekwencyjnie.
+    /// \param compressed Ciąg bajtów w formacie gzip,
+    /// \param options Parametry dekompresji (format jest ignorowany, zawsze gzip),
+    /// \param threads Liczba wątków (0 - liczba rdzeni procesora).
+    /// \return Wektor bajtów po dekompresji lub błąd.
+    extern Result<Vector<char>, Error> decompress_parallel(Span<const char> compressed, DecompressOptions const& options = {}, uint threads = 0) noexcept;
+
+    /// Postęp pojedynczego kroku kompresji/dekompresji strumieniowej.
+    struct Progress {
+        size_t consumed{};  // liczba pobranych bajtów wejściowych
+        size_t produced{};  // liczba bajtów zapisanych do bufora wyjściowego
+        bool done{};        // czy strumień został zakończony
+    };
+
+    /// Odbiorca kolejnych porcji danych wyjściowych.
+    using Sink = std::function<void(Span<const char>)>;
+
+    /****************************************************************
+    *                                                               *
+    *                     G z i p E n c o d e r                     *
+    *                                                               *
+    ****************************************************************/
+
+    /// Kompresor strumieniowy (domyślnie format gzip).
+    /// Dane wejściowe przyjmowane są porcjami, a wynik trafia do wskazanego
+    /// odbiorcy (write/finish) lub do bufora dostarczonego przez wołającego (process).
+    /// Zużycie pamięci nie zależy od rozmiaru danych, tylko od rozmiaru porcji.
+    class GzipEncoder final {
+        Unique<z_stream_s> strm_;
+        Sink sink_;
+        Vector<char> chunk_;
+        bool finished_{};
+    public:
+        static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+        /// Utworzenie kompresora (najlepsza kompresja, jak przed wprowadzeniem CompressOptions).
+        /// \param sink Odbiorca skompresowanych danych (wymagany przez write/finish),
+        /// \param chunk_size Rozmiar wewnętrznego bufora wyjściowego.
+        /// \return Kompresor lub błąd inicjalizacji zlib.
+        static Result<GzipEncoder, Error> create(Sink sink = {}, size_t chunk_size = DefaultChunkSize) noexcept {
+            return create(CompressOptions::best(), std::move(sink), chunk_size);
+        }
+
+        /// Utworzenie kompresora z podanymi parametrami kompresji.
+        static Result<GzipEncoder, Error> create(CompressOptions const& options, Sink sink = {}, size_t chunk_size = DefaultChunkSize) noexcept;
+
+        GzipEncoder(GzipEncoder&& other) noexcept;
+        GzipEncoder& operator=(GzipEncoder&& other) noexcept;
+        GzipEncoder(GzipEncoder const&) = delete;
+        GzipEncoder& operator=(GzipEncoder const&) = delete;
+        ~GzipEncoder();
+
+        /// Kompresja kolejnej porcji danych, wynik przekazywany do odbiorcy.
+        Result<Unit, Error> write(Span<const char> input) noexcept;
+
+        /// Zakończenie strumienia (wypchnięcie reszty danych i stopki gzip).
+        Result<Unit, Error> finish() noexcept;
+
+        /// Pojedynczy krok kompresji do bufora wołającego.
+        /// \param input Dane do kompresji (może być pobrana tylko ich część),
+        /// \param output Bufor na skompresowane dane,
+        /// \param finish Czy to ostatnia porcja danych.
+        /// \return Liczba pobranych i zapisanych bajtów.
+        Result<Progress, Error> process(Span<const char> input, Span<char> output, bool finish = false) noexcept;
+
+        /// Przygotowanie kompresora do nowego strumienia (bez ponownej alokacji stanu).
+        Result<Unit, Error> reset() noexcept;
+
+        /// Górne ograniczenie rozmiaru wyniku kompresji danych o podanym rozmiarze.
+        [[nodiscard]] size_t bound(size_t size) const noexcept;
+
+        /// Ustawienie słownika (deflateSetDictionary).
+        /// Wymaga formatu zlib lub Raw, wywoływane zaraz po create() lub reset().
+        Result<Unit, Error> dictionary(Span<const char> data) noexcept;
+
+    private:
+        GzipEncoder(Unique<z_stream_s> strm, Sink sink, size_t chunk_size) noexcept;
+        Result<Unit, Error> drain(Span<const char> input, int flush) noexcept;
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                     G z i p D e c o d e r                     *
+    *                                                               *
+    ****************************************************************/
+
+    /// Dekompresor strumieniowy (gzip lub zlib rozpoznawany automatycznie, albo sam deflate).
+    /// Obsługuje strumienie złożone z wielu sklejonych członów gzip.
+    class GzipDecoder final {
+        Unique<z_stream_s> strm_;
+        Sink sink_;
+        Vector<char> chunk_;
+        Span<const char> dictionary_{};
+        size_t limit_{std::numeric_limits<size_t>::max()};
+        size_t produced_{};
+        bool ended_{};
+    public:
+        static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+        /// Utworzenie dekompresora.
+        /// \param sink Odbiorca zdekompresowanych danych (wymagany przez write),
+        /// \param chunk_size Rozmiar wewnętrznego bufora wyjściowego,
+        /// \param format Format ramki danych (gzip i zlib rozpoznawane są automatycznie).
+        /// \return Dekompresor lub błąd inicjalizacji zlib.
+        static Result<GzipDecoder, Error> create(Sink sink = {}, size_t chunk_size = DefaultChunkSize, Format format = Format::Gzip) noexcept;
+
+        GzipDecoder(GzipDecoder&& other) noexcept;
+        GzipDecoder& operator=(GzipDecoder&& other) noexcept;
+        GzipDecoder(GzipDecoder const&) = delete;
+        GzipDecoder& operator=(GzipDecoder const&) = delete;
+        ~GzipDecoder();
+
+        /// Dekompresja kolejnej porcji danych, wynik przekazywany do odbiorcy.
+        Result<Unit, Error> write(Span<const char> input) noexcept;
+
+        /// Sprawdzenie, czy strumień został poprawnie zakończony.
+        [[nodiscard]] Result<Unit, Error> finish() const noexcept;
+
+        /// Pojedynczy krok dekompresji do bufora wołającego.
+        /// \param input Dane skompresowane (może być pobrana tylko ich część),
+        /// \param output Bufor na zdekompresowane dane.
+        /// \return Liczba pobranych i zapisanych bajtów.
+        Result<Progress, Error> process(Span<const char> input, Span<char> output) noexcept;
+
+        /// Przygotowanie dekompresora do nowego strumienia.
+        Result<Unit, Error> reset() noexcept;
+
+        /// Wskazanie słownika używanego, gdy strumień zlib go zażąda.
+        /// Dane nie są kopiowane - muszą istnieć tak długo, jak dekompresor z nich korzysta.
+        /// Zgodność słownika (Adler-32) sprawdza zlib.
+        void dictionary(Span<const char> const data) noexcept {
+            dictionary_ = data;
+        }
+
+        /// Ograniczenie łącznego rozmiaru danych po dekompresji (do najbliższego reset()).
+        /// Po jego przekroczeniu write/process zwracają błąd.
+        void limit(size_t const max_output_size) noexcept {
+            limit_ = max_output_size;
+        }
+
+        /// Włączenie lub wyłączenie liczenia i sprawdzania sumy kontrolnej (inflateValidate).
+        Result<Unit, Error> verify(bool check) noexcept;
+
+    private:
+        GzipDecoder(Unique<z_stream_s> strm, Sink sink, size_t chunk_size) noexcept;
+        Result<Unit, Error> use_dictionary() noexcept;
+    };
+
+    /****************************************************************
+    *                                                               *
+    *                     G z i p C o n t e x t                     *
+    *                                                               *
+    ****************************************************************/
+
+    /// Kontekst kompresji wielokrotnego użytku.
+    /// Przechowuje stan zlib (kompresora i dekompresora) pomiędzy wywołaniami,
+    /// kolejne wywołania tylko go zerują (deflateReset/inflateReset) zamiast
+    /// ponownie alokować i inicjalizować. Kontekst nie jest bezpieczny wątkowo,
+    /// każdy wątek powinien mieć własny (patrz local()).
+    class GzipContext final {
+        /// Kompresor zapamiętany dla konkretnych parametrów.
+        struct CachedEncoder {
+            CompressOptions options;
+            GzipEncoder encoder;
+        };
+        /// Liczba zapamiętanych kompresorów (dla różnych parametrów).
+        static constexpr size_t EncoderCacheSize = 4;
+
+        CompressOptions options_;
+        Vector<CachedEncoder> encoders_{};  // ostatnio używany na końcu
+        Option<GzipDecoder> decoder_{};
+        Format decoder_format_{Format::Gzip};
+        Span<const char> dictionary_{};
+    public:
+        explicit GzipContext(CompressOptions const& options = {}) noexcept : options_{options} {}
+
+        /// Kontekst bieżącego wątku (tworzony przy pierwszym użyciu).
+        static GzipContext& local() noexcept;
+
+        [[nodiscard]] CompressOptions const& options() const noexcept {
+            return options_;
+        }
+
+        /// Zmiana parametrów kompresji.
+        /// Kontekst pamięta kompresory dla kilku ostatnio używanych zestawów parametrów,
+        /// więc przeplatanie wywołań z różnymi parametrami nie odtwarza stanu zlib za każdym razem.
+        GzipContext& options(CompressOptions const& options) noexcept {
+            options_ = options;
+            return *this;
+        }
+
+        /// Ustawienie słownika dla kolejnych kompresji i dekompresji (pusty - bez słownika).
+        /// Dane nie są kopiowane - muszą istnieć tak długo, jak kontekst z nich korzysta.
+        GzipContext& dictionary(Span<const char> const data) noexcept {
+            dictionary_ = data;
+            return *this;
+        }
+
+        /// Kompresja bajtów (patrz bee::compress).
+        Result<Vector<char>, Error> compress(Span<const char> plain) noexcept;
+
+        /// Kompresja bajtów do bufora wołającego (patrz bee::compress_into).
+        Result<size_t, Error> compress_into(Span<const char> plain, Span<char> out) noexcept;
+
+        /// Dekompresja bajtów (patrz bee::decompress).
+        Result<Vector<char>, Error> decompress(Span<const char> compressed, DecompressOptions const& options = {}) noexcept;
+
+        /// Dekompresja bajtów do bufora wołającego (patrz bee::decompress_into).
+        Result<size_t, Error> decompress_into(Span<const char> compressed, Span<char> out, DecompressOptions const& options = {}) noexcept;
+
+    private:
+        Result<GzipEncoder*, Error> encoder() noexcept;
+        Result<GzipDecoder*, Error> decoder(DecompressOptions const& options) noexcept;
+    };
+
+    /// Kompresja wielu niezależnych komunikatów z użyciem jednego kontekstu.
+    /// Stan zlib jest inicjalizowany raz na całą paczkę, a nie dla każdego komunikatu.
+    /// \param inputs Komunikaty do kompresji,
+    /// \param options Parametry kompresji.
+    /// \return Wektor skompresowanych komunikatów (w tej samej kolejności) lub błąd.
+    extern Result<Vector<Vector<char>>, Error> compress_many(Span<const Span<const char>> inputs, CompressOptions const& options = {}) noexcept;
+
+    /****************************************************************
+    *                                                               *
+    *                          p l i k i                            *
+    *                                                               *
+    ****************************************************************/
+
+    /// Kompresja pliku.
+    /// Plik wejściowy jest mapowany do pamięci (mmap, odczyt sekwencyjny),
+    /// wynik zapisywany jest do pliku porcjami, bez kopiowania całości do pamięci.
+    /// \param path_in Plik z danymi do kompresji,
+    /// \param path_out Plik wynikowy (nadpisywany, usuwany w razie błędu),
+    /// \param options Parametry kompresji.
+    /// \return Rozmiar pliku wynikowego lub błąd.
+    extern Result<size_t, Error> compress_file(std::filesystem::path const& path_in, std::filesystem::path const& path_out, CompressOptions const& options = {}) noexcept;
+
+    /// Dekompresja pliku.
+    /// Plik wejściowy jest mapowany do pamięci. Jeśli stopka gzip podaje rozmiar
+    /// danych, plik wynikowy jest od razu tworzony w tym rozmiarze i zapisywany
+    /// przez mmap, w przeciwnym razie (lub gdy danych jest więcej) zapis odbywa się porcjami.
+    /// \param path_in Plik ze skompresowanymi danymi,
+    /// \param path_out Plik wynikowy (nadpisywany, usuwany w razie błędu),
+    /// \param options Parametry dekompresji.
+    /// \return Rozmiar pliku wynikowego lub błąd.
+    extern Result<size_t, Error> decompress_file(std::filesystem::path const& path_in, std::filesystem::path const& path_out, DecompressOptions const& options = {}) noexcept;
 }
@@ -0,0 +1,340 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "gzip_index.h"
+#include <zlib.h>
+#include <limits>
+#include <cstring>
+
+namespace bee {
+    namespace {
+        /// Sygnatura i wersja postaci binarnej indeksu.
+        constexpr char Magic[4] = {'B', 'G', 'Z', 'I'};
+        constexpr u8 Version = 1;
+        constexpr size_t MaxAvail = std::numeric_limits<uInt>::max();
+
+        Error index_error(String message) noexcept {
+            return Error(Z_DATA_ERROR, std::move(message));
+        }
+
+        Error zlib_error(int const code, z_stream const& strm) noexcept {
+            if (strm.msg)
+                return Error(code, zError(code), strm.msg);
+            return Error(code, zError(code));
+        }
+
+        /// Strumień inflate zwalniany automatycznie.
+        struct Inflater {
+            z_stream strm{};
+            int status{};
+            explicit Inflater(int const window_bits) noexcept {
+                status = inflateInit2(&strm, window_bits);
+            }
+            Inflater(Inflater const&) = delete;
+            Inflater& operator=(Inflater const&) = delete;
+            ~Inflater() {
+                if (status == Z_OK)
+                    inflateEnd(&strm);
+            }
+
+            /// Podanie kolejnej porcji wejścia (avail_in jest 32-bitowe).
+            void feed(Span<const char>& input) noexcept {
+                if (strm.avail_in == 0 && !input.empty()) {
+                    auto const part = std::min(input.size(), MaxAvail);
+                    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+                    strm.avail_in = static_cast<uInt>(part);
+                    input = input.subspan(part);
+                }
+            }
+        };
+
+        void put_u64(Vector<char>& out, u64 const value) noexcept {
+            for (auto i = 0; i < 8; ++i)
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+
+        /// Odczyt kolejnych pól postaci binarnej (little-endian) z kontrolą rozmiaru.
+        struct Reader {
+            Span<const char> data;
+            bool ok{true};
+
+            u64 get(size_t const n) noexcept {
+                if (data.size() < n) {
+                    ok = false;
+                    return 0;
+                }
+                u64 value{};
+                for (size_t i = 0; i < n; ++i)
+                    value |= u64{static_cast<u8>(data[i])} << (8 * i);
+                data = data.subspan(n);
+                return value;
+            }
+
+            Span<const char> bytes(size_t const n) noexcept {
+                if (data.size() < n) {
+                    ok = false;
+                    return {};
+                }
+                auto const result = data.first(n);
+                data = data.subspan(n);
+                return result;
+            }
+        };
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                            b u i l d                              *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<GzipIndex, Error> GzipIndex::build(Span<const char> const compressed, size_t const span, Format const format) noexcept {
+        GzipIndex index{};
+        index.input_size_ = compressed.size();
+        if (format == Format::Raw)
+            index.trailer_ = 0;
+        else
+            index.trailer_ = (compressed.size() >= 2 && compressed[0] == '\x1f' && compressed[1] == '\x8b') ? 8 : 4;
+
+        Inflater inflater{format == Format::Raw ? -MAX_WBITS : MAX_WBITS + 32};
+        if (inflater.status != Z_OK)
+            return Failure(zlib_error(inflater.status, inflater.strm));
+        auto& strm = inflater.strm;
+
+        // Dane po dekompresji trafiają do bufora cyklicznego o rozmiarze okna,
+        // dzięki czemu w każdej chwili mamy pod ręką ostatnie 32KB.
+        Vector<char> window(WindowSize);
+        auto input = compressed;
+        u64 total_in = 0;
+        u64 total_out = 0;
+        u64 last = 0;
+
+        for (;;) {
+            inflater.feed(input);
+            if (strm.avail_out == 0) {
+                strm.next_out = reinterpret_cast<Bytef*>(window.data());
+                strm.avail_out = static_cast<uInt>(window.size());
+            }
+
+            auto const avail_in = strm.avail_in;
+            auto const avail_out = strm.avail_out;
+            // Z_BLOCK zatrzymuje inflate na granicach bloków deflate.
+            auto const ret = inflate(&strm, Z_BLOCK);
+            total_in += avail_in - strm.avail_in;
+            total_out += avail_out - strm.avail_out;
+
+            if (ret == Z_NEED_DICT)
+                return Failure(index_error("stream requires a dictionary"));
+            if (ret == Z_BUF_ERROR && strm.avail_in == 0 && input.empty())
+                return Failure(index_error("unexpected end of compressed stream"));
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+                return Failure(zlib_error(ret, strm));
+
+            if (ret == Z_STREAM_END) {
+                if (strm.avail_in == 0 && input.empty())
+                    break;
+                // Kolejny człon (sklejone pliki gzip).
+                if (auto const rc = inflateReset(&strm); rc != Z_OK)
+                    return Failure(zlib_error(rc, strm));
+                continue;
+            }
+
+            // Koniec bloku, który nie jest ostatnim blokiem członu - tu można wznowić dekompresję.
+            auto const block_end = (strm.data_type & 128) && !(strm.data_type & 64);
+            if (block_end && (index.points_.empty() || total_out - last >= span)) {
+                Point point{.out = total_out, .in = total_in, .bits = strm.data_type & 7};
+                point.window.resize(WindowSize);
+                auto const left = strm.avail_out;
+                std::memcpy(point.window.data(), window.data() + WindowSize - left, left);
+                std::memcpy(point.window.data() + left, window.data(), WindowSize - left);
+                index.points_.push_back(std::move(point));
+                last = total_out;
+            }
+        }
+
+        index.size_ = total_out;
+        return index;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                          r e a d _ a t                            *
+    *                                                                   *
+    ********************************************************************/
+
+    Result<size_t, Error> GzipIndex::read_at(Span<const char> const compressed, u64 const offset, Span<char> const out) const noexcept {
+        if (compressed.size() != input_size_)
+            return Failure(index_error("index does not match compressed data"));
+        if (offset >= size_ || out.empty() || points_.empty())
+            return 0;
+
+        // Ostatni punkt nie dalej niż żądana pozycja.
+        auto const it = std::ranges::upper_bound(points_, offset, {}, &Point::out);
+        if (it == points_.begin())
+            return Failure(index_error("corrupted gzip index"));
+        auto const& point = *std::prev(it);
+
+        Inflater inflater{-MAX_WBITS};
+        if (inflater.status != Z_OK)
+            return Failure(zlib_error(inflater.status, inflater.strm));
+        auto& strm = inflater.strm;
+
+        // Wznowienie w środku bajtu: brakujące bity bierzemy z bajtu poprzedzającego.
+        if (point.bits) {
+            auto const byte = static_cast<u8>(compressed[point.in - 1]);
+            if (auto const ret = inflatePrime(&strm, point.bits, byte >> (8 - point.bits)); ret != Z_OK)
+                return Failure(zlib_error(ret, strm));
+        }
+        if (auto const ret = inflateSetDictionary(&strm, reinterpret_cast<Bytef const*>(point.window.data()), static_cast<uInt>(point.window.size())); ret != Z_OK)
+            return Failure(zlib_error(ret, strm));
+
+        auto input = compressed.subspan(point.in);
+        auto skip = offset - point.out;
+        Vector<char> discard(std::min<u64>(skip, WindowSize));
+        size_t got = 0;
+        auto raw = true;
+
+        while (got < out.size()) {
+            inflater.feed(input);
+            // Najpierw pomijamy dane pomiędzy punktem a żądaną pozycją.
+            auto const target = skip ? Span<char>{discard}.first(std::min<u64>(skip, discard.size()))
+                                     : out.subspan(got, std::min(out.size() - got, MaxAvail));
+            strm.next_out = reinterpret_cast<Bytef*>(target.data());
+            strm.avail_out = static_cast<uInt>(target.size());
+
+            auto const ret = inflate(&strm, Z_NO_FLUSH);
+            auto const produced = target.size() - strm.avail_out;
+            skip ? skip -= produced : got += produced;
+
+            if (ret == Z_STREAM_END) {
+                if (strm.avail_in == 0 && input.empty())
+                    break;
+                // Koniec członu: w trybie deflate stopkę pomijamy ręcznie,
+                // dalej nagłówki i stopki obsługuje już sam zlib.
+                if (raw) {
+                    for (auto n = trailer_; n > 0; --n) {
+                        inflater.feed(input);
+                        if (strm.avail_in == 0)
+                            break;
+                        ++strm.next_in;
+                        --strm.avail_in;
+                    }
+                    if (strm.avail_in == 0 && input.empty())
+                        break;
+                    if (auto const rc = inflateReset2(&strm, MAX_WBITS + 32); rc != Z_OK)
+                        return Failure(zlib_error(rc, strm));
+                    raw = false;
+                } else if (auto const rc = inflateReset(&strm); rc != Z_OK)
+                    return Failure(zlib_error(rc, strm));
+                continue;
+            }
+            if (ret == Z_BUF_ERROR && strm.avail_in == 0 && input.empty())
+                return Failure(index_error("unexpected end of compressed stream"));
+            if (ret != Z_OK && ret != Z_BUF_ERROR)
+                return Failure(zlib_error(ret, strm));
+        }
+        return got;
+    }
+
+    Result<Vector<char>, Error> GzipIndex::read_at(Span<const char> const compressed, u64 const offset, size_t const len) const noexcept {
+        auto const available = (offset < size_) ? std::min<u64>(len, size_ - offset) : 0;
+        Vector<char> buffer(available);
+        auto const n = read_at(compressed, offset, buffer);
+        if (!n)
+            return Failure(n.error());
+        buffer.resize(*n);
+        return buffer;
+    }
+
+    /********************************************************************
+    *                                                                   *
+    *                     s e r i a l i z a c j a                       *
+    *                                                                   *
+    ********************************************************************/
+
+    // Układ (little-endian):
+    //   "BGZI" | wersja u8 | stopka u8 | rozmiar u64 | rozmiar wejścia u64 | liczba punktów u64
+    //   punkt: out u64 | in u64 | bits u8 | rozmiar okna u64 | okno
+    Vector<char> GzipIndex::serialize() const noexcept {
+        Vector<char> out{};
+        out.reserve(30 + points_.size() * (17 + 8 + WindowSize));
+        for (auto const c : Magic)
+            out.push_back(c);
+        out.push_back(static_cast<char>(Version));
+        out.push_back(static_cast<char>(trailer_));
+        put_u64(out, size_);
+        put_u64(out, input_size_);
+        put_u64(out, points_.size());
+        for (auto const& point : points_) {
+            put_u64(out, point.out);
+            put_u64(out, point.in);
+            out.push_back(static_cast<char>(point.bits));
+            put_u64(out, point.window.size());
+            out.insert(out.end(), point.window.begin(), point.window.end());
+        }
+        return out;
+    }
+
+    Result<GzipIndex, Error> GzipIndex::deserialize(Span<const char> const data) noexcept {
+        Reader reader{data};
+        auto const magic = reader.bytes(sizeof(Magic));
+        if (!reader.ok || !std::equal(magic.begin(), magic.end(), std::begin(Magic)))
+            return Failure(index_error("not a gzip index"));
+        if (reader.get(1) != Version)
+            return Failure(index_error("unsupported gzip index version"));
+
+        GzipIndex index{};
+        index.trailer_ = static_cast<u8>(reader.get(1));
+        index.size_ = reader.get(8);
+        index.input_size_ = reader.get(8);
+        auto const count = reader.get(8);
+        if (!reader.ok || count > reader.data.size())
+            return Failure(index_error("truncated gzip index"));
+
+        index.points_.reserve(count);
+        for (u64 i = 0; i < count; ++i) {
+            Point point{};
+            point.out = reader.get(8);
+            point.in = reader.get(8);
+            point.bits = static_cast<int>(reader.get(1));
+            auto const window = reader.bytes(reader.get(8));
+            if (!reader.ok)
+                return Failure(index_error("truncated gzip index"));
+            if (point.bits > 7 || point.in > index.input_size_ || (point.bits && point.in == 0) || window.size() > WindowSize)
+                return Failure(index_error("corrupted gzip index"));
+            // Pierwszy punkt to początek danych, kolejne leżą coraz dalej (i nie za końcem danych).
+            auto const prev_out = index.points_.empty() ? 0 : index.points_.back().out;
+            auto const prev_in = index.points_.empty() ? 0 : index.points_.back().in;
+            if ((i == 0 && point.out != 0) || (i > 0 && point.out <= prev_out) || point.out > index.size_ || point.in < prev_in)
+                return Failure(index_error("corrupted gzip index"));
+            point.window.assign(window.begin(), window.end());
+            index.points_.push_back(std::move(point));
+        }
+        return index;
+    }
+}
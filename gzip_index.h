@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "error.h"
+#include "gzip.h"
+
+namespace bee {
+    /****************************************************************
+    *                                                               *
+    *                       G z i p I n d e x                       *
+    *                                                               *
+    ****************************************************************/
+
+    /// Indeks swobodnego dostępu do skompresowanych danych (gzip, zlib lub sam deflate).
+    /// Co określoną liczbę bajtów danych po dekompresji zapamiętywany jest punkt
+    /// kontrolny: pozycja w obu strumieniach, przesunięcie bitowe i ostatnie 32KB
+    /// danych (okno). Odczyt fragmentu zaczyna się od najbliższego wcześniejszego
+    /// punktu, a nie od początku danych.
+    class GzipIndex final {
+    public:
+        /// Rozmiar okna deflate zapamiętywanego w każdym punkcie.
+        static constexpr size_t WindowSize = 32 * 1024;
+        /// Domyślna odległość pomiędzy punktami kontrolnymi (w danych po dekompresji).
+        static constexpr size_t DefaultSpan = 1024 * 1024;
+
+        /// Punkt kontrolny.
+        struct Point {
+            u64 out{};              // pozycja w danych po dekompresji
+            u64 in{};               // pozycja w danych skompresowanych (pierwszy pełny bajt)
+            int bits{};             // liczba bitów (0-7) do pobrania z bajtu poprzedzającego 'in'
+            Vector<char> window{};  // dane poprzedzające punkt (słownik dla inflate)
+        };
+
+    private:
+        Vector<Point> points_{};
+        u64 size_{};        // rozmiar danych po dekompresji
+        u64 input_size_{};  // rozmiar danych skompresowanych
+        u8 trailer_{};      // rozmiar stopki członu (gzip 8, zlib 4, deflate 0)
+
+    public:
+        GzipIndex() = default;
+        GzipIndex(GzipIndex const&) = default;
+        GzipIndex(GzipIndex&&) = default;
+        GzipIndex& operator=(GzipIndex const&) = default;
+        GzipIndex& operator=(GzipIndex&&) = default;
+        ~GzipIndex() = default;
+
+        /// Budowa indeksu (jednorazowa dekompresja całości).
+        /// \param compressed Skompresowane dane (np. zmapowany plik .gz),
+        /// \param span Minimalna odległość pomiędzy punktami kontrolnymi,
+        /// \param format Format ramki danych (gzip i zlib rozpoznawane są automatycznie).
+        /// \return Indeks lub błąd (np. uszkodzone dane).
+        static Result<GzipIndex, Error> build(Span<const char> compressed, size_t span = DefaultSpan, Format format = Format::Gzip) noexcept;
+
+        /// Odczyt fragmentu danych po dekompresji.
+        /// \param compressed Te same skompresowane dane, dla których zbudowano indeks,
+        /// \param offset Pozycja w danych po dekompresji,
+        /// \param out Bufor na odczytane dane.
+        /// \return Liczba odczytanych bajtów (mniej niż rozmiar bufora tylko na końcu danych) lub błąd.
+        Result<size_t, Error> read_at(Span<const char> compressed, u64 offset, Span<char> out) const noexcept;
+
+        /// Odczyt fragmentu danych po dekompresji do nowego wektora.
+        Result<Vector<char>, Error> read_at(Span<const char> compressed, u64 offset, size_t len) const noexcept;
+
+        /// Zapis indeksu do postaci binarnej (np. do pliku obok archiwum).
+        [[nodiscard]] Vector<char> serialize() const noexcept;
+
+        /// Odtworzenie indeksu z postaci binarnej.
+        static Result<GzipIndex, Error> deserialize(Span<const char> data) noexcept;
+
+        /// Rozmiar danych po dekompresji.
+        [[nodiscard]] u64 size() const noexcept {
+            return size_;
+        }
+        [[nodiscard]] Span<const Point> points() const noexcept {
+            return points_;
+        }
+    };
+}
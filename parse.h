@@ -0,0 +1,192 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+#include "error.h"
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <bit>
+
+namespace bee {
+    /// Reguły odczytu liczby z tekstu.
+    struct ParseOptions {
+        bool skip_space{};  // pomijanie początkowych białych znaków
+        bool plus_sign{};   // akceptacja znaku '+' przed liczbą
+        bool partial{};     // dopuszczalne znaki za liczbą (np. "12px")
+        int base{10};       // podstawa systemu (tylko liczby całkowite)
+
+        /// Cały tekst musi być liczbą (jak std::from_chars z kontrolą końca tekstu).
+        static constexpr ParseOptions strict() noexcept {
+            return {};
+        }
+        /// Białe znaki przed liczbą, znak '+' i dowolne znaki za liczbą są dopuszczalne.
+        static constexpr ParseOptions lenient() noexcept {
+            return {.skip_space = true, .plus_sign = true, .partial = true};
+        }
+    };
+
+    /// Błąd odczytu jednej z wielu liczb (parse_many).
+    struct ParseError {
+        size_t index{};     // numer tekstu, którego nie udało się odczytać
+        Errc code{};        // invalid_argument lub result_out_of_range
+    };
+
+    namespace detail {
+        constexpr bool is_ascii_space(char const c) noexcept {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        /// Czy 8 bajtów to same cyfry dziesiętne?
+        constexpr bool all_digits8(u64 const chunk) noexcept {
+            return ((chunk & 0xf0f0'f0f0'f0f0'f0f0) | (((chunk + 0x0606'0606'0606'0606) & 0xf0f0'f0f0'f0f0'f0f0) >> 4)) == 0x3333'3333'3333'3333;
+        }
+
+        /// Wartość 8 cyfr dziesiętnych (kolejność bajtów little-endian, SWAR - 3 mnożenia).
+        constexpr u64 digits8(u64 chunk) noexcept {
+            chunk = (chunk & 0x0f0f'0f0f'0f0f'0f0f) * 2561 >> 8;
+            chunk = (chunk & 0x00ff'00ff'00ff'00ff) * 6553601 >> 16;
+            return (chunk & 0x0000'ffff'0000'ffff) * 42949672960001 >> 32;
+        }
+
+        /// Odczyt ciągu cyfr dziesiętnych (maksymalnie 19 - wynik mieści się w u64 bez przepełnienia).
+        /// \return Wartość i liczba cyfr; 20 cyfr oznacza, że ciąg jest dłuższy.
+        inline Pair<u64, size_t> decimal(char const* const first, char const* const last) noexcept {
+            u64 value = 0;
+            auto p = first;
+            if constexpr (std::endian::native == std::endian::little) {
+                while (last - p >= 8 && (p - first) <= 11) {
+                    u64 chunk;
+                    std::memcpy(&chunk, p, sizeof(chunk));
+                    if (!all_digits8(chunk))
+                        break;
+                    value = value * 100'000'000 + digits8(chunk);
+                    p += 8;
+                }
+            }
+            while (p != last && static_cast<u8>(*p - '0') < 10 && p - first < 20) {
+                value = value * 10 + static_cast<u8>(*p - '0');
+                ++p;
+            }
+            return {value, static_cast<size_t>(p - first)};
+        }
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                          p a r s e                            *
+    *                                                               *
+    ****************************************************************/
+
+    /// Odczyt liczby z tekstu (bez alokacji i bez wypisywania komunikatów).
+    /// Liczby dziesiętne odczytywane są po 8 cyfr naraz (SWAR), pozostałe przez std::from_chars.
+    /// \param text Tekst zawierający liczbę,
+    /// \param options Reguły odczytu (domyślnie ścisłe).
+    /// \return Liczba lub kod błędu: invalid_argument (to nie jest liczba) albo result_out_of_range.
+    template<Scalar T>
+    Result<T, Errc> parse(StringView text, ParseOptions const& options = {}) noexcept {
+        auto first = text.data();
+        auto const last = first + text.size();
+
+        if (options.skip_space)
+            while (first != last && detail::is_ascii_space(*first))
+                ++first;
+        if (options.plus_sign && first != last && *first == '+') {
+            ++first;
+            // Po '+' nie może być kolejnego znaku liczby.
+            if (first != last && (*first == '-' || *first == '+'))
+                return Failure(Errc::invalid_argument);
+        }
+
+        T value{};
+        char const* end = nullptr;
+        if constexpr (std::integral<T>) {
+            if (options.base == 10) {
+                auto const negative = (first != last && *first == '-');
+                if (negative && std::is_unsigned_v<T>)
+                    return Failure(Errc::invalid_argument);
+                auto const digits_begin = first + negative;
+                auto const [magnitude, count] = detail::decimal(digits_begin, last);
+                if (count == 0)
+                    return Failure(Errc::invalid_argument);
+                if (count < 20) {
+                    using Limits = std::numeric_limits<T>;
+                    auto const max = static_cast<u64>(Limits::max()) + (negative ? 1 : 0);
+                    if (magnitude > max)
+                        return Failure(Errc::result_out_of_range);
+                    value = negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+                    end = digits_begin + count;
+                }
+            }
+            // Inna podstawa lub bardzo długi ciąg cyfr (np. z zerami wiodącymi).
+            if (!end) {
+                auto const [ptr, ec] = std::from_chars(first, last, value, options.base);
+                if (ec != Errc{})
+                    return Failure(ec);
+                end = ptr;
+            }
+        } else {
+            auto const [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != Errc{})
+                return Failure(ec);
+            end = ptr;
+        }
+
+        if (!options.partial && end != last)
+            return Failure(Errc::invalid_argument);
+        return value;
+    }
+
+    /// Odczyt kolumny liczb do bufora wołającego.
+    /// \param texts Teksty zawierające liczby,
+    /// \param out Bufor na wyniki (co najmniej texts.size() elementów),
+    /// \param options Reguły odczytu.
+    /// \return Sukces lub numer pierwszego tekstu, którego nie udało się odczytać (z kodem błędu).
+    template<Scalar T>
+    Result<Unit, ParseError> parse_many(Span<const StringView> const texts, Span<T> const out, ParseOptions const& options = {}) noexcept {
+        if (out.size() < texts.size())
+            return Failure(ParseError{.index = out.size(), .code = Errc::no_buffer_space});
+        for (size_t i = 0; i < texts.size(); ++i) {
+            auto const value = parse<T>(texts[i], options);
+            if (!value)
+                return Failure(ParseError{.index = i, .code = value.error()});
+            out[i] = *value;
+        }
+        return Success;
+    }
+
+    /// Odczyt kolumny liczb do nowego wektora.
+    template<Scalar T>
+    Result<Vector<T>, ParseError> parse_many(Span<const StringView> const texts, ParseOptions const& options = {}) {
+        Vector<T> values(texts.size());
+        if (auto const ok = parse_many<T>(texts, Span<T>{values}, options); !ok)
+            return Failure(ok.error());
+        return values;
+    }
+}
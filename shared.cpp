@@ -27,9 +27,208 @@
 /*------- include files:
 -------------------------------------------------------------------*/
 #include "shared.h"
+#include "cpu.h"
 #include <string>
+#include <cstring>
+#include <cerrno>
+#include <bit>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 namespace bee {
+    namespace {
+        constexpr u64 Ones = 0x0101'0101'0101'0101;
+        constexpr u64 High = 0x8080'8080'8080'8080;
+
+        /// Zamiana pojedynczego znaku na małą literę (tylko ASCII).
+        constexpr char lower(char const c) noexcept {
+            return (static_cast<u8>(c - 'A') < 26) ? static_cast<char>(c | 0x20) : c;
+        }
+
+        /// Zamiana pojedynczego znaku na wielką literę (tylko ASCII).
+        constexpr char upper(char const c) noexcept {
+            return (static_cast<u8>(c - 'a') < 26) ? static_cast<char>(c & ~0x20) : c;
+        }
+
+        /// Zamiana na małe litery 8 znaków naraz (SWAR, bez przenoszenia pomiędzy bajtami).
+        constexpr u64 lower8(u64 const x) noexcept {
+            auto const heptets = x & ~High;
+            auto const above_z = heptets + Ones * (0x7f - 'Z');
+            auto const from_a = heptets + Ones * (0x80 - 'A');
+            auto const is_upper = (above_z ^ from_a) & ~x & High;
+            return x | (is_upper >> 2);
+        }
+
+        inline u64 load8(char const* const p) noexcept {
+            u64 value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+#if defined(__x86_64__)
+        /// Zamiana liter z przedziału [first, first + 25] - XOR z 0x20 (SSE2).
+        template<char First>
+        void convert_sse2(StringView const in, char* const out, size_t& i) noexcept {
+            auto const first = _mm_set1_epi8(First);
+            auto const range = _mm_set1_epi8(25);
+            auto const flip = _mm_set1_epi8(0x20);
+            for (; i + 16 <= in.size(); i += 16) {
+                auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in.data() + i));
+                auto const shifted = _mm_sub_epi8(v, first);
+                auto const letter = _mm_cmpeq_epi8(_mm_min_epu8(shifted, range), shifted);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(v, _mm_and_si128(letter, flip)));
+            }
+        }
+
+        template<char First>
+        __attribute__((target("avx2")))
+        void convert_avx2(StringView const in, char* const out, size_t& i) noexcept {
+            auto const first = _mm256_set1_epi8(First);
+            auto const range = _mm256_set1_epi8(25);
+            auto const flip = _mm256_set1_epi8(0x20);
+            for (; i + 32 <= in.size(); i += 32) {
+                auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in.data() + i));
+                auto const shifted = _mm256_sub_epi8(v, first);
+                auto const letter = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, range), shifted);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(v, _mm256_and_si256(letter, flip)));
+            }
+        }
+
+        /// Kodowanie hex 16 bajtów na krok: półbajty zamieniane na cyfry przez pshufb.
+        __attribute__((target("ssse3")))
+        void hex_encode_ssse3(Span<const u8> const bytes, char* const out, char const* const digits, size_t& i) noexcept {
+            auto const table = _mm_loadu_si128(reinterpret_cast<__m128i const*>(digits));
+            auto const nibble = _mm_set1_epi8(0x0f);
+            for (; i + 16 <= bytes.size(); i += 16) {
+                auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes.data() + i));
+                auto const hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+                auto const lo = _mm_shuffle_epi8(table, _mm_and_si128(v, nibble));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+            }
+        }
+
+        /// Kodowanie hex 32 bajtów na krok (AVX2).
+        __attribute__((target("avx2")))
+        void hex_encode_avx2(Span<const u8> const bytes, char* const out, char const* const digits, size_t& i) noexcept {
+            auto const table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(digits)));
+            auto const nibble = _mm256_set1_epi8(0x0f);
+            for (; i + 32 <= bytes.size(); i += 32) {
+                auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes.data() + i));
+                auto const hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                auto const lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+                // unpack działa w obrębie 128-bitowych połówek - składamy je we właściwej kolejności.
+                auto const first = _mm256_unpacklo_epi8(hi, lo);
+                auto const second = _mm256_unpackhi_epi8(hi, lo);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+            }
+        }
+#endif
+
+        /// Wartości cyfr szesnastkowych (0xff - znak nie jest cyfrą).
+        constexpr auto HexValues = [] {
+            Array<u8, 256> table{};
+            table.fill(0xff);
+            for (int i = 0; i < 10; ++i)
+                table['0' + i] = static_cast<u8>(i);
+            for (int i = 0; i < 6; ++i) {
+                table['a' + i] = static_cast<u8>(10 + i);
+                table['A' + i] = static_cast<u8>(10 + i);
+            }
+            return table;
+        }();
+
+        /// Odczyt bajtu z dwóch cyfr (Option pusty, gdy któryś znak nie jest cyfrą).
+        constexpr Option<u8> hex_byte(char const hi, char const lo) noexcept {
+            auto const h = HexValues[static_cast<u8>(hi)];
+            auto const l = HexValues[static_cast<u8>(lo)];
+            if (h > 15 || l > 15)
+                return {};
+            return static_cast<u8>(h << 4 | l);
+        }
+
+        Error hex_error(size_t const position) noexcept {
+            return Error(EINVAL, "invalid hex text", std::format("position {}", position));
+        }
+
+        /// Zamiana liter z przedziału [First, First + 25] w całym tekście.
+        template<char First>
+        void convert(StringView const in, char* const out) noexcept {
+            size_t i = 0;
+#if defined(__x86_64__)
+            if (cpu::has_avx2())
+                convert_avx2<First>(in, out, i);
+            convert_sse2<First>(in, out, i);
+#endif
+            for (; i < in.size(); ++i)
+                out[i] = (First == 'A') ? lower(in[i]) : upper(in[i]);
+        }
+    }
+
+    /****************************************************************
+     *                                                               *
+     *                       t o _ l o w e r                         *
+     *                                                               *
+     ****************************************************************/
+
+    void ascii_to_lower(StringView const in, char* const out) noexcept {
+        convert<'A'>(in, out);
+    }
+
+    void ascii_to_upper(StringView const in, char* const out) noexcept {
+        convert<'a'>(in, out);
+    }
+
+    bool iequals(StringView const a, StringView const b) noexcept {
+        if (a.size() != b.size())
+            return false;
+        size_t i = 0;
+        for (; i + 8 <= a.size(); i += 8)
+            if (lower8(load8(a.data() + i)) != lower8(load8(b.data() + i)))
+                return false;
+        for (; i < a.size(); ++i)
+            if (lower(a[i]) != lower(b[i]))
+                return false;
+        return true;
+    }
+
+    std::strong_ordering icompare(StringView const a, StringView const b) noexcept {
+        auto const size = std::min(a.size(), b.size());
+        size_t i = 0;
+        // Słowa pomijamy, dopóki są równe - różnicę rozstrzygamy znak po znaku.
+        while (i + 8 <= size && lower8(load8(a.data() + i)) == lower8(load8(b.data() + i)))
+            i += 8;
+        for (; i < size; ++i) {
+            auto const x = static_cast<u8>(lower(a[i]));
+            auto const y = static_cast<u8>(lower(b[i]));
+            if (x != y)
+                return x <=> y;
+        }
+        return a.size() <=> b.size();
+    }
+
+    size_t ihash(StringView const s) noexcept {
+        constexpr u64 K = 0x9e37'79b9'7f4a'7c15;
+        u64 h = K ^ s.size();
+        size_t i = 0;
+        for (; i + 8 <= s.size(); i += 8)
+            h = std::rotl((h ^ lower8(load8(s.data() + i))) * K, 31);
+        if (i < s.size()) {
+            u64 tail = 0;
+            std::memcpy(&tail, s.data() + i, s.size() - i);
+            h = std::rotl((h ^ lower8(tail)) * K, 31);
+        }
+        // Końcowe wymieszanie bitów (murmur3 fmix64).
+        h ^= h >> 33;
+        h *= 0xff51'afd7'ed55'8ccd;
+        h ^= h >> 33;
+        h *= 0xc4ce'b9fe'1a85'ec53;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
     /****************************************************************
      *                                                               *
      *                          j o i n                              *
@@ -37,33 +236,60 @@ namespace bee {
      ****************************************************************/
 
     String join(Span<const String> const data, char const delimiter, Option<char> const spacer) noexcept {
-        if (data.empty())
-            return {};
+        char const separator[] = {delimiter, spacer.value_or('\0')};
+        String buffer;
+        join_into(buffer, data, StringView{separator, spacer ? 2u : 1u});
+        return buffer;
+    }
 
-        // Obliczamy sumaryczną długość wszystkich stringów.
-        size_t size = 0;
-        for (auto const &str: data)
-            size += str.length();
+    /****************************************************************
+     *                                                               *
+     *                      b y t e s 2 h e x                        *
+     *                                                               *
+     ****************************************************************/
 
-        // Liczba dodatkowych znaków, znaki delimiterów.
-        auto n = data.size() - 1;
-        // Jeśli ma być dodawany spacer, to liczba dodatkowych znaków się podwaja.
-        if (spacer)
-            n *= 2;
+    void hex_encode(Span<const u8> const bytes, char* const out, bool const upper) noexcept {
+        size_t i = 0;
+#if defined(__x86_64__)
+        auto const digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        if (cpu::has_avx2())
+            hex_encode_avx2(bytes, out, digits, i);
+        if (cpu::has_ssse3())
+            hex_encode_ssse3(bytes, out, digits, i);
+#endif
+        auto const table = upper ? HexTable<true>.data() : HexTable<false>.data();
+        for (; i < bytes.size(); ++i)
+            std::memcpy(out + 2 * i, table + 2 * bytes[i], 2);
+    }
 
-        size += n;
-        String buffer;
-        buffer.reserve(size);
+    Result<Vector<u8>, Error> hex2bytes(StringView const text) noexcept {
+        Vector<u8> bytes;
 
-        for (auto it = data.begin(); it != std::prev(data.end()); ++it) {
-            buffer.append(*it);
-            buffer.push_back(delimiter);
-            if (spacer)
-                buffer.push_back(*spacer);
+        // Zapis bez separatorów.
+        if (!text.starts_with("0x") && !text.starts_with("0X")) {
+            if (text.size() % 2)
+                return Failure(hex_error(text.size()));
+            bytes.resize(text.size() / 2);
+            for (size_t i = 0; i < bytes.size(); ++i) {
+                auto const byte = hex_byte(text[2 * i], text[2 * i + 1]);
+                if (!byte)
+                    return Failure(hex_error(2 * i));
+                bytes[i] = *byte;
+            }
+            return bytes;
         }
-        buffer.append(*std::prev(data.end()));
-        buffer.shrink_to_fit();
 
-        return std::move(buffer);
+        // Zapis "0x01,0xff" - każda część po obcięciu białych znaków to prefiks i dwie cyfry.
+        bytes.reserve(text.size() / 5 + 1);
+        for (auto const part : split_range(text, ',', true)) {
+            auto const position = static_cast<size_t>(part.data() - text.data());
+            if (part.size() != 4 || part[0] != '0' || (part[1] != 'x' && part[1] != 'X'))
+                return Failure(hex_error(position));
+            auto const byte = hex_byte(part[2], part[3]);
+            if (!byte)
+                return Failure(hex_error(position));
+            bytes.push_back(*byte);
+        }
+        return bytes;
     }
 }
@@ -29,6 +29,8 @@
 -------------------------------------------------------------------*/
 #include "types.h"
 #include "error.h"
+#include "tokenizer.h"
+#include "parse.h"
 #include <span>
 #include <optional>
 #include <string>
@@ -36,7 +38,13 @@
 #include <format>
 #include <vector>
 #include <algorithm>
+#include <ranges>
+#include <iterator>
+#include <compare>
 #include <charconv>
+#include <cstring>
+#include <bit>
+#include <limits>
 #include <print>
 #include <pwd.h>
 #include <unistd.h>
@@ -77,18 +85,67 @@ namespace bee {
         return Error(ec.value(), ec.message());
     }
 
+    /// Tablica białych znaków ASCII (te same, co std::isspace w locale "C").
+    inline constexpr auto SpaceTable = [] {
+        Array<bool, 256> table{};
+        for (auto const c : StringView{" \t\n\v\f\r"})
+            table[static_cast<u8>(c)] = true;
+        return table;
+    }();
+
+    /// Sprawdzenie, czy przysłany znak jest białym znakiem (ASCII, niezależnie od locale).
+    constexpr bool is_space(char const c) noexcept {
+        return SpaceTable[static_cast<u8>(c)];
+    }
+
     /// Sprawdzenie, czy przysłany znak NIE jest białym znakiem.
     /// \param c Znak do sprawdzenia
     /// \return TRUE, jeśli NIE jest białym znakiem, FALSE w przeciwnym przypadku (jest białym znakiem).
-    inline bool is_not_space (char const c) noexcept {
-        return !std::isspace(c);
+    constexpr bool is_not_space(char const c) noexcept {
+        return !is_space(c);
+    }
+
+    /// Pominięcie początkowych białych znaków bez kopiowania tekstu.
+    /// Pierwszy znak sprawdzany jest bezpośrednio, dłuższe ciągi białych znaków pomijane są SIMD.
+    /// \param sv Tekst, z którego należy usunąć białe znaki
+    /// \return Widok na tekst bez początkowych białych znaków.
+    constexpr StringView trim_left_view(StringView const sv) noexcept {
+        if consteval {
+            return sv.substr(std::min(sv.find_first_not_of(" \t\n\v\f\r"), sv.size()));
+        } else {
+            // Najczęściej pole nie zaczyna się od białego znaku.
+            if (sv.empty() || is_not_space(sv.front()))
+                return sv;
+            return sv.substr(skip_spaces(sv));
+        }
+    }
+
+    /// Pominięcie końcowych białych znaków bez kopiowania tekstu.
+    /// \param sv Tekst, z którego należy usunąć białe znaki
+    /// \return Widok na tekst bez końcowych białych znaków.
+    constexpr StringView trim_right_view(StringView const sv) noexcept {
+        if consteval {
+            auto const pos = sv.find_last_not_of(" \t\n\v\f\r");
+            return sv.substr(0, pos == StringView::npos ? 0 : pos + 1);
+        } else {
+            if (sv.empty() || is_not_space(sv.back()))
+                return sv;
+            return sv.substr(0, skip_spaces_back(sv));
+        }
+    }
+
+    /// Usunięcie początkowych i końcowych białych znaków bez kopiowania tekstu.
+    /// \param sv Tekst, z którego należy usunąć białe znaki
+    /// \return Widok na fragment tekstu bez początkowych i końcowych białych znaków.
+    constexpr StringView trim_view(StringView const sv) noexcept {
+        return trim_right_view(trim_left_view(sv));
     }
 
     /// Obcięcie początkowych białych znaków.
     /// \param s Tekst, z którego należy usunąć białe znaki
     /// \return Tekst bez początkowych białych znaków.
     inline String trim_left(String s) noexcept {
-        s.erase(s.begin(), std::ranges::find_if(s, is_not_space));
+        s.erase(0, s.size() - trim_left_view(s).size());
         return s;
     }
 
@@ -96,7 +153,7 @@ namespace bee {
     /// \param s Tekst, z którego należy usunąć białe znaki
     /// \return Tekst bez zamykających białych znaków.
     inline String trim_right(String s) noexcept {
-        s.erase(std::find_if(s.rbegin(), s.rend(), is_not_space).base(), s.end());
+        s.resize(trim_right_view(s).size());
         return s;
     }
 
@@ -104,7 +161,11 @@ namespace bee {
     /// \param s Tekst, z którego należy usunąć białe znaki
     /// \return Tekst bez początkowych i końcowych białych znaków.
     inline String trim(String s) noexcept {
-        return trim_left(trim_right(std::move(s)));
+        auto const view = trim_view(s);
+        auto const offset = static_cast<size_t>(view.data() - s.data());
+        s.resize(offset + view.size());
+        s.erase(0, offset);
+        return s;
     }
 
     /****************************************************************
@@ -113,47 +174,168 @@ namespace bee {
     *                                                               *
     ****************************************************************/
 
+    /// Leniwy podział tekstu na części (widoki na tekst źródłowy, bez alokacji).
+    /// Części są obcinane z białych znaków, puste części pomijane (chyba że accept_empty).
+    /// Tekst źródłowy musi żyć dłużej niż zakres i jego iteratory.
+    class SplitRange : public std::ranges::view_interface<SplitRange> {
+    public:
+        class Iterator {
+            StringView text_{};
+            StringView field_{};
+            size_t next_{};
+            char delimiter_{','};
+            bool accept_empty_{};
+            bool done_{true};
+        public:
+            using value_type = StringView;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::forward_iterator_tag;
+
+            constexpr Iterator() noexcept = default;
+            constexpr Iterator(StringView const text, char const delimiter, bool const accept_empty) noexcept
+                : text_{text}, delimiter_{delimiter}, accept_empty_{accept_empty}, done_{false}
+            {
+                advance();
+            }
+
+            constexpr StringView operator*() const noexcept { return field_; }
+            constexpr Iterator& operator++() noexcept { advance(); return *this; }
+            constexpr Iterator operator++(int) noexcept { auto tmp = *this; advance(); return tmp; }
+            constexpr bool operator==(Iterator const& other) const noexcept {
+                return done_ == other.done_ && (done_ || (next_ == other.next_ && text_.data() == other.text_.data()));
+            }
+            constexpr bool operator==(std::default_sentinel_t) const noexcept { return done_; }
+
+        private:
+            /// Przejście do następnej części. Pozycja za końcem tekstu oznacza,
+            /// że ostatnia część (niezakończona delimiterem) została już wydana.
+            constexpr void advance() noexcept {
+                while (next_ <= text_.size()) {
+                    auto end = text_.find(delimiter_, next_);
+                    if (end == StringView::npos)
+                        end = text_.size();
+                    auto const field = trim_view(text_.substr(next_, end - next_));
+                    next_ = end + 1;
+                    if (!field.empty() || accept_empty_) {
+                        field_ = field;
+                        return;
+                    }
+                }
+                done_ = true;
+            }
+        };
+
+        constexpr SplitRange() noexcept = default;
+        constexpr SplitRange(StringView const text, char const delimiter, bool const accept_empty) noexcept
+            : text_{text}, delimiter_{delimiter}, accept_empty_{accept_empty}
+        {}
+
+        constexpr Iterator begin() const noexcept { return Iterator{text_, delimiter_, accept_empty_}; }
+        static constexpr std::default_sentinel_t end() noexcept { return {}; }
+
+    private:
+        StringView text_{};
+        char delimiter_{','};
+        bool accept_empty_{};
+    };
+
+    /// Leniwy podział tekstu na części w miejscach znaku 'delimiter'.
+    /// \param sv Tekst do podziału (musi żyć dłużej niż zwrócony zakres),
+    /// \param delimiter Znak rozdzielający części tekstu,
+    /// \param accept_empty Czy puste części też zachować?
+    /// \return Zakres widoków na obcięte części tekstu.
+    constexpr SplitRange split_range(StringView const sv, char const delimiter = ',', bool const accept_empty = false) noexcept {
+        return SplitRange{sv, delimiter, accept_empty};
+    }
+
+    /// Podział tekstu na części bez kopiowania znaków.
+    /// \param sv Tekst do podziału (musi żyć dłużej niż zwrócone widoki),
+    /// \param delimiter Znak rozdzielający części tekstu,
+    /// \param accept_empty Czy puste części też zachować?
+    /// \return Wektor widoków na obcięte części tekstu.
+    inline Vector<StringView> split_views(StringView const sv, char const delimiter = ',', bool const accept_empty = false) noexcept {
+        Vector<StringView> result;
+        result.reserve(count_char(sv, delimiter) + 1);
+        for (auto const field : split_range(sv, delimiter, accept_empty))
+            result.push_back(field);
+        return result;
+    }
+
     /// Podział tekstu na części. Podział w miejscach znaku 'delimiter'.
     /// \param sv String do podziału,
     /// \param delimiter Znak rozdzielający części tekstu,
     /// \param accept_empty Czy puste części też zachować?
     /// \return Wektor zawierający części tekstu.
-    Vector<String> split(Stringable auto sv, char delimiter = ',', bool accept_empty = false) noexcept {
+    Vector<String> split(Stringable auto const& sv, char delimiter = ',', bool accept_empty = false) noexcept {
         // Liczymy ile będzie znaków podziałów, aby zaalokować wynikowy wektor w stosownym rozmiarze.
-        size_t n{};
-        for (auto it = sv.begin(); it != sv.end(); ++it)
-            if (*it == delimiter)
-                ++n;
-
-        // Wynikowy wektor ma 'n + 1' elementów
+        StringView const text{sv};
         Vector<String> result;
-        result.reserve(n + 1);
-        // Bufor na zbieranie znaków linii.
-        String line{};
-
-        // Funkcja, dodająca (lub nie) aktualną linię do wynikowego wektora.
-        // Po jej zakończeniu zawartość linii jest usuwana.
-        auto add = [&line, &result, accept_empty]() {
-            if (auto const text = trim(line); text.empty()) {
-                if (accept_empty)
-                    result.emplace_back("");
-            } else {
-                result.emplace_back(text);
-            }
-            line.clear();
-        };
+        result.reserve(count_char(text, delimiter) + 1);
 
-        // Obsługa elementów wewnętrznych.
-        for (auto const c : sv)
-            (c == delimiter) ? add() : line.push_back(c);
+        // Każda część jest kopiowana tylko raz - już po obcięciu białych znaków.
+        for (auto const field : split_range(text, delimiter, accept_empty))
+            result.emplace_back(field);
+        return result;
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                          j o i n                              *
+    *                                                               *
+    ****************************************************************/
 
-        // Obsłuż ostatni element (niezakończony delimiterem).
-        add();
+    /// Zakres elementów, które można potraktować jak tekst (String, StringView, const char*...).
+    template<typename R>
+    concept StringRange = std::ranges::input_range<R>
+        && std::convertible_to<std::ranges::range_reference_t<R>, StringView>;
+
+    /// Połączenie tekstów z zakresu i przekazanie wyniku do iteratora wyjściowego
+    /// (np. bezpośrednio do bufora gniazda), bez tworzenia tekstu pośredniego.
+    /// \param out Iterator wyjściowy,
+    /// \param data Zakres tekstów,
+    /// \param separator Tekst wstawiany pomiędzy składniki (może mieć wiele znaków).
+    /// \return Iterator za ostatnim zapisanym znakiem.
+    template<std::output_iterator<char> Out>
+    Out join_to(Out out, StringRange auto&& data, StringView const separator = ",") {
+        auto first = true;
+        for (auto&& item : data) {
+            if (!first)
+                out = std::ranges::copy(separator, out).out;
+            first = false;
+            out = std::ranges::copy(StringView{item}, out).out;
+        }
+        return out;
+    }
 
-        result.shrink_to_fit();
-        return result;
+    /// Dopisanie połączonych tekstów na końcu istniejącego tekstu (jedna rezerwacja pamięci,
+    /// gdy zakres można przejść dwukrotnie).
+    /// \param out Tekst, do którego dopisujemy,
+    /// \param data Zakres tekstów,
+    /// \param separator Tekst wstawiany pomiędzy składniki (może mieć wiele znaków).
+    void join_into(String& out, StringRange auto&& data, StringView const separator = ",") {
+        if constexpr (std::ranges::forward_range<decltype(data)>) {
+            size_t size = 0;
+            size_t n = 0;
+            for (auto&& item : data) {
+                size += StringView{item}.size();
+                ++n;
+            }
+            if (n == 0)
+                return;
+            out.reserve(out.size() + size + (n - 1) * separator.size());
+        }
+        join_to(std::back_inserter(out), data, separator);
     }
 
+    /// Połączenie tekstów z dowolnego zakresu w jeden tekst.
+    /// \param data Zakres tekstów (np. Vector<StringView> z split_views),
+    /// \param separator Tekst wstawiany pomiędzy składniki (domyślnie przecinek).
+    /// \return Połączony tekst.
+    String join(StringRange auto&& data, StringView const separator = ",") {
+        String buffer;
+        join_into(buffer, data, separator);
+        return buffer;
+    }
 
     /// Połączenie wektora tekstów w jeden tekst (jedna linia).
     /// \param data Wektor stringów,
@@ -168,19 +350,80 @@ namespace bee {
     *                                                               *
     ****************************************************************/
 
+    /// Tablica cyfr szesnastkowych: dla każdej wartości bajtu dwa znaki.
+    template<bool Upper>
+    inline constexpr auto HexTable = [] {
+        constexpr StringView digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        Array<char, 512> table{};
+        for (size_t i = 0; i < 256; ++i) {
+            table[2 * i] = digits[i >> 4];
+            table[2 * i + 1] = digits[i & 0xf];
+        }
+        return table;
+    }();
+
+    /// Widok bajtów dowolnego ciągłego kontenera elementów jednobajtowych.
+    Span<const u8> as_u8_span(std::ranges::contiguous_range auto const& data) noexcept {
+        static_assert(sizeof(std::ranges::range_value_t<decltype(data)>) == 1);
+        return Span<const u8>{reinterpret_cast<u8 const*>(std::ranges::data(data)), std::ranges::size(data)};
+    }
+
+    /// Zapis bajtów jako cyfr szesnastkowych (po 2 znaki na bajt, bez separatorów).
+    /// Bloki 16/32 bajtów kodowane są instrukcją pshufb (SSSE3/AVX2, wybór w trakcie działania).
+    /// \param bytes Bajty do zapisu,
+    /// \param out Bufor docelowy na '2 * bytes.size()' znaków,
+    /// \param upper Czy używać wielkich liter (A-F)?
+    void hex_encode(Span<const u8> bytes, char* out, bool upper = false) noexcept;
+
+    /// Utworzenie hex-tekstu z ciągu bajtów, bez prefiksów i separatorów (np. "01ff").
+    String to_hex(std::ranges::contiguous_range auto const& bytes, bool const upper = false) noexcept {
+        auto const data = as_u8_span(bytes);
+        String text;
+        text.resize_and_overwrite(2 * data.size(), [data, upper](char* const buffer, size_t) {
+            hex_encode(data, buffer, upper);
+            return 2 * data.size();
+        });
+        return text;
+    }
+
     /// Utworzenie hex-tekstu z ciągu bajtów.
     /// Bajty będą oddzielone od siebie przecinkiem.
     /// Po przecinku może być dodany opcjonalny separator, np. spacja.
-    String bytes2hex(Vectorizable auto const bytes, std::optional<char> const spacer = {}) noexcept {
-        Vector<String> result;
-        result.reserve(bytes.size());
-
-        for (u8 c : bytes)
-            result.push_back(std::format("0x{:02x}", c));
+    String bytes2hex(Vectorizable auto const& bytes, std::optional<char> const spacer = {}) noexcept {
+        auto const data = as_u8_span(bytes);
+        if (data.empty())
+            return {};
 
-        return join(result, ',', spacer);
+        // Każdy bajt to "0x" i dwie cyfry, pomiędzy bajtami przecinek i ewentualnie separator.
+        auto const step = spacer ? 6 : 5;
+        auto const size = data.size() * step - (step - 4);
+        String text;
+        text.resize_and_overwrite(size, [data, spacer, step, size](char* const buffer, size_t) {
+            auto out = buffer;
+            for (auto const c : data) {
+                out[0] = '0';
+                out[1] = 'x';
+                out[2] = HexTable<false>[2 * c];
+                out[3] = HexTable<false>[2 * c + 1];
+                // Ostatni bajt bez przecinka i separatora.
+                if (out + 4 == buffer + size)
+                    break;
+                out[4] = ',';
+                if (spacer)
+                    out[5] = *spacer;
+                out += step;
+            }
+            return size;
+        });
+        return text;
     }
 
+    /// Odczyt bajtów z hex-tekstu. Akceptowany jest zapis bez separatorów ("01ff", wielkość liter dowolna)
+    /// oraz zapis tworzony przez bytes2hex ("0x01,0xff", także z separatorem po przecinku).
+    /// \param text Tekst do konwersji.
+    /// \return Bajty lub błąd (nieprawidłowy znak lub nieparzysta liczba cyfr).
+    Result<Vector<u8>, Error> hex2bytes(StringView text) noexcept;
+
     /****************************************************************
     *                                                               *
     *                   f r o m _ b y t e s                         *
@@ -189,11 +432,13 @@ namespace bee {
 
     /// Konwersja wektora bajtów na liczbę całkowitą o wskazanym typie (rozmiarze).
     /// Liczba bajtów musi być równa lub większa od wskazanego typu wynikowego.
+    /// Bajty w kolejności natywnej - przy jawnej kolejności bajtów należy użyć ByteReader (bytes.h).
     template<std::integral T>
-    std::optional<T> from_bytes(Vectorizable auto const span) noexcept {
+    std::optional<T> from_bytes(Vectorizable auto const& span) noexcept {
         if (span.size() >= sizeof(T)) {
+            // memcpy zamiast rzutowania wskaźnika - dane nie muszą być wyrównane.
             T value{};
-            value = *reinterpret_cast<T const*>(span.first(sizeof(T)).data());
+            std::memcpy(&value, span.data(), sizeof(T));
             return value;
         }
         return {};
@@ -214,7 +459,8 @@ namespace bee {
     *                                                               *
     ****************************************************************/
 
-    /// Konwersja liczby całkowitej na wektor bajtów.
+    /// Konwersja liczby całkowitej na wektor bajtów (kolejność natywna).
+    /// Ramki złożone z wielu pól lepiej budować jednym ByteWriter (bytes.h).
     template<std::integral T>
     Vector<u8> to_bytes(T const value) noexcept {
         Vector<u8> bytes;
@@ -231,11 +477,16 @@ namespace bee {
 
     /// Zamiana liczby całkowitej na string.
     String as_string(std::integral auto const v) {
-        return std::to_string(static_cast<i64>(v));
+        char buffer[24];
+        auto const [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<i64>(v));
+        return String{buffer, end};
     }
-    /// Zamiana liczby zmiennoprzecinkowej na string.
+    /// Zamiana liczby zmiennoprzecinkowej na string (6 miejsc po przecinku, jak std::to_string,
+    /// ale niezależnie od locale).
     String as_string(std::floating_point auto v) {
-        return std::to_string(static_cast<f64>(v));
+        char buffer[512];
+        auto const [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<f64>(v), std::chars_format::fixed, 6);
+        return String{buffer, end};
     }
 
     /****************************************************************
@@ -244,40 +495,109 @@ namespace bee {
     *                                                               *
     ****************************************************************/
 
+    /// Zamiana liter ASCII na małe (po 16/32 znaki naraz, SSE2/AVX2).
+    /// Pozostałe znaki (także bajty spoza ASCII) są przepisywane bez zmian.
+    /// \param in Tekst źródłowy,
+    /// \param out Bufor docelowy na 'in.size()' znaków (może to być bufor tekstu źródłowego).
+    void ascii_to_lower(StringView in, char* out) noexcept;
+
+    /// Zamiana liter ASCII na wielkie (po 16/32 znaki naraz, SSE2/AVX2).
+    /// \param in Tekst źródłowy,
+    /// \param out Bufor docelowy na 'in.size()' znaków (może to być bufor tekstu źródłowego).
+    void ascii_to_upper(StringView in, char* out) noexcept;
+
     /// Zmiana wszystkich znaków w tekście na małe litery.
     /// \param s Tekst do konwersji,
     /// \return Tekst, w którym wszystkie litery są małe.
-    String to_lower(Stringable auto const s) noexcept {
+    String to_lower(Stringable auto const& s) noexcept {
+        StringView const text{s};
         String data;
-        data.reserve(s.size());
+        data.resize_and_overwrite(text.size(), [text](char* const buffer, size_t) {
+            ascii_to_lower(text, buffer);
+            return text.size();
+        });
+        return data;
+    }
 
-        for (auto const c : s)
-            data.push_back(static_cast<char>(std::tolower(c)));
+    /// Zmiana wszystkich znaków w tekście na wielkie litery.
+    /// \param s Tekst do konwersji,
+    /// \return Tekst, w którym wszystkie litery są wielkie.
+    String to_upper(Stringable auto const& s) noexcept {
+        StringView const text{s};
+        String data;
+        data.resize_and_overwrite(text.size(), [text](char* const buffer, size_t) {
+            ascii_to_upper(text, buffer);
+            return text.size();
+        });
         return data;
     }
 
+    /// Zmiana liter na małe do bufora wołającego.
+    /// \param s Tekst do konwersji,
+    /// \param out Bufor docelowy (zamieniana jest tylko część tekstu, która się w nim mieści).
+    /// \return Widok na zapisaną część bufora.
+    inline StringView to_lower(StringView const s, Span<char> const out) noexcept {
+        auto const text = s.substr(0, out.size());
+        ascii_to_lower(text, out.data());
+        return StringView{out.data(), text.size()};
+    }
+
+    /// Zmiana liter na wielkie do bufora wołającego.
+    /// \param s Tekst do konwersji,
+    /// \param out Bufor docelowy (zamieniana jest tylko część tekstu, która się w nim mieści).
+    /// \return Widok na zapisaną część bufora.
+    inline StringView to_upper(StringView const s, Span<char> const out) noexcept {
+        auto const text = s.substr(0, out.size());
+        ascii_to_upper(text, out.data());
+        return StringView{out.data(), text.size()};
+    }
+
+    /// Zmiana liter na małe w miejscu (bez alokacji).
+    inline void to_lower_inplace(String& s) noexcept {
+        ascii_to_lower(s, s.data());
+    }
+
+    /// Zmiana liter na wielkie w miejscu (bez alokacji).
+    inline void to_upper_inplace(String& s) noexcept {
+        ascii_to_upper(s, s.data());
+    }
+
+    /// Porównanie tekstów bez uwzględnienia wielkości liter ASCII (bez tworzenia kopii).
+    bool iequals(StringView a, StringView b) noexcept;
+
+    /// Porządek tekstów bez uwzględnienia wielkości liter ASCII (jak porównanie małymi literami).
+    std::strong_ordering icompare(StringView a, StringView b) noexcept;
+
+    /// Skrót tekstu niezależny od wielkości liter ASCII (iequals(a, b) => ihash(a) == ihash(b)).
+    size_t ihash(StringView s) noexcept;
+
+    /// Funkcja skrótu dla kontenerów z kluczami bez rozróżniania wielkości liter,
+    /// np. std::unordered_map<String, T, CaseInsensitiveHash, CaseInsensitiveEqual>.
+    struct CaseInsensitiveHash {
+        using is_transparent = void;
+        size_t operator()(StringView const s) const noexcept { return ihash(s); }
+    };
+
+    /// Porównanie kluczy bez rozróżniania wielkości liter (para dla CaseInsensitiveHash).
+    struct CaseInsensitiveEqual {
+        using is_transparent = void;
+        bool operator()(StringView const a, StringView const b) const noexcept { return iequals(a, b); }
+    };
+
     /****************************************************************
     *                                                               *
     *                        t o _ i n t                            *
     *                                                               *
     ****************************************************************/
 
-    /// Zamiana tekstu na liczbę całkowitą.
+    /// Zamiana tekstu na liczbę całkowitą (znaki za liczbą są pomijane).
+    /// Nie wypisuje komunikatów - przyczynę błędu zwraca parse<T>.
     /// \param s Tekst zawierający liczbę,
     /// \param radix Format-system zapisanej liczby.
     /// \return Liczba całkowita, jeśli wszystko dobrze.
-    Option<int> to_int(Stringable auto const s, int const radix = 10) noexcept {
-        int value = 0;
-        auto const [_, ec] = std::from_chars(s.data(), s.data() + s.size(), value, radix);
-
-        if (ec == std::errc{})
-            return value;
-
-        // Coś poszło nie tak.
-        if (ec == std::errc::invalid_argument)
-            std::println(std::cerr, "This is not a number ({}).", s);
-        else if (ec == std::errc::result_out_of_range)
-            std::println(std::cerr, "The number is to big ({}).", s);
+    Option<int> to_int(Stringable auto const& s, int const radix = 10) noexcept {
+        if (auto const value = parse<int>(StringView{s}, {.partial = true, .base = radix}))
+            return *value;
         return {};
     }
 
@@ -287,32 +607,112 @@ namespace bee {
     *                                                               *
     ****************************************************************/
 
-    /// Zamiana liczby całkowitej na string z separatorami pomiędzy
-    /// grupami tysięcy.
-    String fmt_as_string(std::integral auto const value, char const separator = '.') noexcept {
-        auto const text = std::to_string(value);
-        auto const size = text.size();
-        String buffer{};
-        buffer.reserve(size + size/3);
-        auto offset{0};
-
-        if (value < 0) {
-            buffer.push_back('-');
-            offset = 1;
+    /// Pary cyfr "00" ... "99" (zapis liczby po dwie cyfry na krok).
+    inline constexpr auto DigitPairs = [] {
+        Array<char, 200> table{};
+        for (size_t i = 0; i < 100; ++i) {
+            table[2 * i] = static_cast<char>('0' + i / 10);
+            table[2 * i + 1] = static_cast<char>('0' + i % 10);
         }
+        return table;
+    }();
+
+    /// Liczba cyfr dziesiętnych liczby.
+    constexpr size_t count_digits(u64 const value) noexcept {
+        constexpr Array<u64, 20> powers = [] {
+            Array<u64, 20> table{};
+            u64 p = 1;
+            for (auto& x : table) {
+                x = p;
+                p *= 10;
+            }
+            return table;
+        }();
+        // Przybliżenie log10 z liczby bitów (1233/4096 ≈ log10(2)), poprawiane jednym porównaniem.
+        auto const v = value | 1;
+        auto const n = static_cast<size_t>(std::bit_width(v) * 1233 >> 12);
+        return n + 1 - (v < powers[n] ? 1 : 0);
+    }
 
-        auto comma_idx = 3 - (size - offset) % 3;
-        if (comma_idx == 3) comma_idx = 0;
-
-        for (auto i = offset; i < size; ++i) {
-            if (comma_idx == 3) {
-                buffer.push_back(separator);
-                comma_idx = 0;
+    /// Maksymalna długość liczby typu T zapisanej z separatorami tysięcy (ze znakiem minus).
+    template<std::integral T>
+    inline constexpr size_t MaxGroupedSize = (std::numeric_limits<T>::digits10 + 1) * 4 / 3 + 1;
+
+    /// Zapis liczby całkowitej z separatorami pomiędzy grupami tysięcy do bufora wołającego.
+    /// Grupy zapisywane są od końca, po dwie cyfry na krok (bez pośredniego tekstu).
+    /// \param out Bufor na co najmniej MaxGroupedSize<T> znaków,
+    /// \param value Liczba do zapisu,
+    /// \param separator Znak oddzielający grupy tysięcy.
+    /// \return Wskaźnik za ostatnim zapisanym znakiem.
+    template<std::integral T>
+    char* format_to(char* out, T const value, char const separator = '.') noexcept {
+        u64 v = static_cast<u64>(value);
+        if constexpr (std::is_signed_v<T>)
+            if (value < 0) {
+                *out++ = '-';
+                v = 0 - v;
             }
-            ++comma_idx;
-            buffer.push_back(text[i]);
+
+        auto const digits = count_digits(v);
+        auto const end = out + digits + (digits - 1) / 3;
+        auto p = end;
+        auto const put3 = [&p](u64 const group) {
+            p -= 3;
+            p[0] = static_cast<char>('0' + group / 100);
+            std::memcpy(p + 1, DigitPairs.data() + 2 * (group % 100), 2);
+        };
+        while (v >= 1000) {
+            put3(v % 1000);
+            v /= 1000;
+            *--p = separator;
         }
+        if (v >= 100)
+            put3(v);
+        else if (v >= 10)
+            std::memcpy(p - 2, DigitPairs.data() + 2 * v, 2);
+        else
+            p[-1] = static_cast<char>('0' + v);
+        return end;
+    }
+
+    /// Dopisanie liczby z separatorami tysięcy na końcu tekstu (bufor tekstu jest używany ponownie).
+    void format_to(String& out, std::integral auto const value, char const separator = '.') noexcept {
+        char buffer[MaxGroupedSize<decltype(value)>];
+        out.append(buffer, format_to(buffer, value, separator));
+    }
 
-        return std::move(buffer);
+    /// Zamiana liczby całkowitej na string z separatorami pomiędzy
+    /// grupami tysięcy.
+    String fmt_as_string(std::integral auto const value, char const separator = '.') noexcept {
+        char buffer[MaxGroupedSize<decltype(value)>];
+        return String{buffer, format_to(buffer, value, separator)};
     }
+
+    /// Liczba całkowita do formatowania z separatorami tysięcy przez std::format.
+    /// Znak separatora podawany jest jako specyfikacja formatu, np. std::format("{:.}", Grouped{n})
+    /// daje "1.234.567", a "{: }" - "1 234 567" (domyślnie kropka).
+    template<std::integral T>
+    struct Grouped {
+        T value;
+    };
 }
+
+template<typename T>
+struct std::formatter<bee::Grouped<T>> {
+    char separator{'.'};
+
+    constexpr auto parse(std::format_parse_context& ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it != '}')
+            separator = *it++;
+        if (it != ctx.end() && *it != '}')
+            throw std::format_error("invalid format specification for Grouped");
+        return it;
+    }
+
+    auto format(bee::Grouped<T> const& number, std::format_context& ctx) const {
+        char buffer[bee::MaxGroupedSize<T>];
+        auto const end = bee::format_to(buffer, number.value, separator);
+        return std::copy(buffer, end, ctx.out());
+    }
+};
@@ -0,0 +1,208 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+
+// Testy ścieżki czasu: TimeZone (zmiany czasu w tablicy i poza nią), tekst daty,
+// BasicTimestamp, kubełkowanie kalendarzowe i zegar monotoniczny.
+// Strefa testowa: Europe/Warsaw (CET/CEST, zmiany w ostatnie niedziele marca i października).
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "../datime.h"
+#include "../calendar.h"
+#include "../clock.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    using namespace bee;
+
+    int failures = 0;
+
+    void check(bool const ok, char const* const expr, int const line) {
+        if (!ok) {
+            std::printf("FAILED (line %d): %s\n", line, expr);
+            ++failures;
+        }
+    }
+    #define CHECK(expr) check((expr), #expr, __LINE__)
+
+    constexpr i64 Hour = 3600;
+
+    /// Ostatnia niedziela miesiąca (numer dnia od początku epoki).
+    i64 last_sunday(i32 const y, u32 const m) {
+        auto day = days_from_civil(y, m, days_in_month(y, m));
+        while (iso_weekday_from_days(day) != 7)
+            --day;
+        return day;
+    }
+
+    i64 to_local(i64 const utc) {
+        return TimeZone::to_local(TimeZone::zone(), date::sys_seconds{Seconds{utc}}).time_since_epoch().count();
+    }
+
+    i64 to_sys(i64 const local) {
+        return TimeZone::to_sys(TimeZone::zone(), date::local_seconds{Seconds{local}}).time_since_epoch().count();
+    }
+
+    String iso(i64 const utc, i64 const offset) {
+        char buffer[IsoDatetimeSize];
+        return String{buffer, format_iso8601(buffer, utc, offset)};
+    }
+
+    /// Zmiana na czas letni (02:00 CET -> 03:00 CEST, 01:00 UTC) i na zimowy
+    /// (03:00 CEST -> 02:00 CET, 01:00 UTC) w roku 'y'.
+    void test_transitions(i32 const y) {
+        auto const spring = last_sunday(y, 3) * SecondsPerDay + Hour;
+        auto const autumn = last_sunday(y, 10) * SecondsPerDay + Hour;
+
+        // Luka: czas lokalny 02:00-03:00 nie istnieje, przesuwany jest o godzinę do przodu.
+        CHECK(to_local(spring - 1) == spring - 1 + Hour);
+        CHECK(to_local(spring) == spring + 2 * Hour);
+        CHECK(to_sys(spring + Hour + 30 * 60) == spring + 30 * 60);
+        CHECK(to_local(to_sys(spring + Hour + 30 * 60)) == spring + 2 * Hour + 30 * 60);
+
+        // Nakładka: czas lokalny 02:00-03:00 występuje dwa razy, wybierana jest wcześniejsza chwila.
+        CHECK(to_local(autumn - 30 * 60) == autumn + Hour + 30 * 60);
+        CHECK(to_local(autumn + 30 * 60) == autumn + Hour + 30 * 60);
+        CHECK(to_sys(autumn + Hour + 30 * 60) == autumn - 30 * 60);
+
+        // Tam i z powrotem co kwadrans przez oba tygodnie zmian.
+        for (auto const start : {spring, autumn})
+            for (auto t = start - 3 * SecondsPerDay; t < start + 3 * SecondsPerDay; t += 15 * 60) {
+                auto const local = to_local(t);
+                auto const back = to_sys(local);
+                CHECK(back == t || (back == t - Hour && to_local(back) == local));
+            }
+    }
+
+    void test_time_zone() {
+        CHECK(TimeZone::warm_up("Europe/Warsaw").has_value());
+        CHECK(!TimeZone::warm_up("Europe/Warsaw", 2000, 1999).has_value());
+        CHECK(!TimeZone::warm_up("No/Such_Zone").has_value());
+        CHECK(TimeZone::zone()->name() == "Europe/Warsaw");
+
+        test_transitions(2024);     // w zakresie tablicy przesunięć
+        test_transitions(2300);     // poza tablicą - reguły strefy, ta sama zasada
+    }
+
+    void test_text() {
+        auto const parsed = parse_datetime("2024-03-31T03:30:00+02:00");
+        CHECK(parsed.has_value() && parsed->utc);
+        CHECK(parsed && iso(parsed->seconds, 2 * Hour) == "2024-03-31T03:30:00+02:00");
+
+        auto const local = parse_datetime("2024-10-27 02:30:15");
+        CHECK(local && !local->utc && local->seconds == days_from_civil(2024, 10, 27) * SecondsPerDay + 2 * Hour + 30 * 60 + 15);
+
+        auto const fraction = parse_datetime("1969-12-31T23:59:59.25Z");
+        CHECK(fraction && fraction->utc && fraction->seconds == -1 && fraction->nanoseconds == 250'000'000);
+        CHECK(iso(-1, -90 * 60) == "1969-12-31T22:29:59-01:30");
+
+        CHECK(parse_datetime("2024-02-30 00:00:00").error() == Errc::result_out_of_range);
+        CHECK(!parse_datetime("2024-10-27 02:30").has_value());
+        CHECK(!parse_datetime("2024-10-27T02:30:00+2").has_value());
+
+        // Czas lokalny z tekstu przez strefę: luka i nakładka jak w TimeZone::to_sys.
+        CHECK(Datime::parse("2024-03-31 02:30:00")->to_string() == "2024-03-31 03:30:00");
+        CHECK(Datime::parse("2024-10-27 02:30:00")->to_iso_string() == "2024-10-27T02:30:00+02:00");
+        CHECK(Datime::parse("2024-10-27T00:30:00Z")->to_iso_string() == "2024-10-27T02:30:00+02:00");
+        CHECK(Datime::parse("2024-10-27T01:30:00Z")->to_iso_string() == "2024-10-27T02:30:00+01:00");
+        CHECK(Datime("2024-07-01 12:00:00").timestamp() == days_from_civil(2024, 7, 1) * SecondsPerDay + 10 * Hour);
+
+        StringView const texts[] = {"2024-01-01 01:00:00", "2024-01-01T00:00:00Z"};
+        i64 out[2]{};
+        CHECK(parse_datetimes(texts, out).has_value() && out[0] == out[1]);
+        String column{};
+        format_datetimes(out, column);
+        CHECK(column == "2024-01-01 01:00:00\n2024-01-01 01:00:00\n");
+    }
+
+    void test_timestamp() {
+        using std::chrono::milliseconds;
+        CHECK(Timestamp{10}.milliseconds_since(MicroTimestamp{9'500'000}) == 500);
+        CHECK(MicroTimestamp{1'500}.milliseconds_since(Timestamp{0}) == 1);
+        CHECK(MicroTimestamp{-1}.seconds_since(Timestamp{0}) == -1);
+        CHECK(Timestamp{0}.minutes_since(Timestamp{61}) == -2);
+        CHECK(Timestamp{61}.minutes_since(Timestamp{0}) == 1);
+        CHECK(NanoTimestamp{1}.nanoseconds_since(MilliTimestamp{0}) == 1);
+        CHECK(MilliTimestamp{2'000}.microseconds_since(MilliTimestamp{1'999}) == 1'000);
+        CHECK(MicroTimestamp{-1}.cast<milliseconds>().count() == -1);
+        CHECK(Timestamp{-1}.radix_key() < Timestamp{0}.radix_key());
+
+        // Datime liczy 'other - this' z minutami zaokrąglanymi osobno (patrz opis minutes_since).
+        CHECK(Datime(i64{59}).minutes_since(Datime(i64{61})) == 1);
+
+        auto const t = days_from_civil(2024, 10, 27) * SecondsPerDay + 30 * 60;
+        CHECK(Timestamp{Datime(t)}.count() == t);
+        CHECK(Timestamp{t}.to_datime().timestamp() == t);
+        CHECK(Timestamp{t}.to_string() == "2024-10-27 02:30:00");
+        CHECK(Timestamp{t}.week_day() == 7);
+        auto const time = Timestamp{t + Hour}.time();
+        CHECK(time.h == 2 && time.m == 30 && time.s == 0);
+    }
+
+    void test_calendar() {
+        auto const spring = days_from_civil(2024, 3, 31) * SecondsPerDay + 12 * Hour;
+        auto const autumn = days_from_civil(2024, 10, 27) * SecondsPerDay + 12 * Hour;
+        i64 const utc[] = {spring, autumn, days_from_civil(2024, 10, 26) * SecondsPerDay + 22 * Hour + 30 * 60};
+        i64 days[3]{}, weeks[3]{}, begins[3]{}, ends[3]{};
+        i32 months[3]{};
+        u8 week_days[3]{};
+        day_keys(utc, days);
+        week_keys(utc, weeks);
+        month_keys(utc, months);
+        bee::week_days(utc, week_days);
+        day_bounds(utc, begins, ends);
+
+        CHECK(days[0] == days_from_civil(2024, 3, 31) && days[2] == days_from_civil(2024, 10, 27));
+        CHECK(weeks[0] == days_from_civil(2024, 3, 25) && weeks[1] == days_from_civil(2024, 10, 21));
+        CHECK(months[0] == 2024 * 12 + 2 && months[1] == 2024 * 12 + 9);
+        CHECK(week_days[0] == 7 && week_days[2] == 7);
+        CHECK(ends[0] - begins[0] + 1 == 23 * Hour);
+        CHECK(ends[1] - begins[1] + 1 == 25 * Hour);
+        CHECK(begins[2] == begins[1]);
+    }
+
+    void test_clock() {
+        MonotonicClock::warm_up();
+        auto const a = MonotonicClock::now();
+        auto const b = MonotonicClock::now();
+        CHECK(b >= a);
+        CHECK(std::abs(NanoTimestamp::now().milliseconds_since(b)) < 1'000);
+        Stopwatch const watch{};
+        CHECK(watch.nanoseconds() >= 0);
+    }
+}
+
+int main() {
+    test_time_zone();
+    test_text();
+    test_timestamp();
+    test_calendar();
+    test_clock();
+    if (failures)
+        std::printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
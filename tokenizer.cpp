@@ -0,0 +1,210 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "tokenizer.h"
+#include "shared.h"
+#include "cpu.h"
+#include <bit>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace bee {
+    namespace {
+        /// Zapamiętanie granic pól wskazanych bitami maski (bit 'i' odpowiada znakowi 'base + i').
+        inline void emit(u64 mask, size_t const base, char const* const data, Tokens& tokens) noexcept {
+            while (mask) {
+                auto const pos = base + static_cast<size_t>(std::countr_zero(mask));
+                tokens.ends.push_back(pos);
+                if (data[pos] == '\n')
+                    tokens.rows.push_back(tokens.ends.size());
+                mask &= mask - 1;
+            }
+        }
+
+        /// Tokenizacja znak po znaku (końcówka bufora lub procesor bez SIMD).
+        void tokenize_scalar(StringView const text, char const delimiter, Tokens& tokens, size_t const from) noexcept {
+            for (auto i = from; i < text.size(); ++i)
+                if (text[i] == delimiter || text[i] == '\n')
+                    emit(1, i, text.data(), tokens);
+        }
+
+        size_t count_scalar(StringView const text, char const c, size_t const from) noexcept {
+            size_t n = 0;
+            for (auto i = from; i < text.size(); ++i)
+                n += (text[i] == c);
+            return n;
+        }
+
+#if defined(__x86_64__)
+        // SSE2 jest zawsze dostępne na x86-64, AVX2 sprawdzamy w trakcie działania.
+
+        void tokenize_sse2(StringView const text, char const delimiter, Tokens& tokens) noexcept {
+            auto const data = text.data();
+            auto const d = _mm_set1_epi8(delimiter);
+            auto const nl = _mm_set1_epi8('\n');
+            size_t i = 0;
+            for (; i + 16 <= text.size(); i += 16) {
+                auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+                auto const mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, nl)));
+                emit(static_cast<u32>(mask), i, data, tokens);
+            }
+            tokenize_scalar(text, delimiter, tokens, i);
+        }
+
+        __attribute__((target("avx2")))
+        void tokenize_avx2(StringView const text, char const delimiter, Tokens& tokens) noexcept {
+            auto const data = text.data();
+            auto const d = _mm256_set1_epi8(delimiter);
+            auto const nl = _mm256_set1_epi8('\n');
+            size_t i = 0;
+            // 64 bajty na krok - jedna 64-bitowa maska z dwóch rejestrów.
+            for (; i + 64 <= text.size(); i += 64) {
+                auto const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+                auto const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + 32));
+                auto const mlo = static_cast<u32>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(lo, d), _mm256_cmpeq_epi8(lo, nl))));
+                auto const mhi = static_cast<u32>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(hi, d), _mm256_cmpeq_epi8(hi, nl))));
+                emit(static_cast<u64>(mhi) << 32 | mlo, i, data, tokens);
+            }
+            tokenize_scalar(text, delimiter, tokens, i);
+        }
+
+        size_t count_sse2(StringView const text, char const c) noexcept {
+            auto const data = text.data();
+            auto const v = _mm_set1_epi8(c);
+            size_t n = 0;
+            size_t i = 0;
+            for (; i + 16 <= text.size(); i += 16) {
+                auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+                n += static_cast<size_t>(std::popcount(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, v)))));
+            }
+            return n + count_scalar(text, c, i);
+        }
+
+        __attribute__((target("avx2,popcnt")))
+        size_t count_avx2(StringView const text, char const c) noexcept {
+            auto const data = text.data();
+            auto const v = _mm256_set1_epi8(c);
+            size_t n = 0;
+            size_t i = 0;
+            for (; i + 32 <= text.size(); i += 32) {
+                auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+                n += static_cast<size_t>(std::popcount(static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, v)))));
+            }
+            return n + count_scalar(text, c, i);
+        }
+
+        /// Maska białych znaków ASCII w bloku 16 bajtów: ' ' oraz znaki 9-13 ('\t' ... '\r').
+        inline u32 space_mask(__m128i const v) noexcept {
+            auto const space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+            auto const shifted = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+            auto const control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+            return static_cast<u32>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+        }
+#endif
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                  t o k e n i z e _ l i n e s                  *
+    *                                                               *
+    ****************************************************************/
+
+    Tokens tokenize_lines(StringView const text, char const delimiter) noexcept {
+        Tokens tokens;
+        tokenize_lines(text, delimiter, tokens);
+        return tokens;
+    }
+
+    void tokenize_lines(StringView const text, char const delimiter, Tokens& tokens) noexcept {
+        tokens.text = text;
+        tokens.ends.clear();
+        tokens.rows.clear();
+        tokens.rows.push_back(0);
+
+#if defined(__x86_64__)
+        cpu::has_avx2() ? tokenize_avx2(text, delimiter, tokens) : tokenize_sse2(text, delimiter, tokens);
+#else
+        tokenize_scalar(text, delimiter, tokens, 0);
+#endif
+
+        // Ostatni wiersz niezakończony znakiem '\n'.
+        if (!text.empty() && text.back() != '\n') {
+            tokens.ends.push_back(text.size());
+            tokens.rows.push_back(tokens.ends.size());
+        }
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                     c o u n t _ c h a r                       *
+    *                                                               *
+    ****************************************************************/
+
+    size_t count_char(StringView const text, char const c) noexcept {
+#if defined(__x86_64__)
+        return cpu::has_avx2() ? count_avx2(text, c) : count_sse2(text, c);
+#else
+        return count_scalar(text, c, 0);
+#endif
+    }
+
+    /****************************************************************
+    *                                                               *
+    *                     s k i p _ s p a c e s                     *
+    *                                                               *
+    ****************************************************************/
+
+    size_t skip_spaces(StringView const text) noexcept {
+        size_t i = 0;
+#if defined(__x86_64__)
+        for (; i + 16 <= text.size(); i += 16) {
+            auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text.data() + i));
+            if (auto const mask = ~space_mask(block) & 0xffff)
+                return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+#endif
+        while (i < text.size() && is_space(text[i]))
+            ++i;
+        return i;
+    }
+
+    size_t skip_spaces_back(StringView const text) noexcept {
+        auto end = text.size();
+#if defined(__x86_64__)
+        for (; end >= 16; end -= 16) {
+            auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text.data() + end - 16));
+            if (auto const mask = ~space_mask(block) & 0xffff)
+                return end - 16 + static_cast<size_t>(std::bit_width(mask));
+        }
+#endif
+        while (end > 0 && is_space(text[end - 1]))
+            --end;
+        return end;
+    }
+}
@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2024 Piotr Pszczółkowski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author: Piotr Pszczółkowski
+// Date: 16.10.2026
+// E-mail: piotr@beesoft.pl.
+#pragma once
+
+/*------- include files:
+-------------------------------------------------------------------*/
+#include "types.h"
+
+namespace bee {
+    /****************************************************************
+    *                                                               *
+    *                        T o k e n s                            *
+    *                                                               *
+    ****************************************************************/
+
+    /// Wynik tokenizacji bufora: granice pól i wierszy.
+    /// Pola nie są obcinane z białych znaków (np. '\r' przed '\n' zostaje w ostatnim polu).
+    /// Widoki zwracane przez field() wskazują na tokenizowany tekst, który musi żyć dłużej.
+    struct Tokens {
+        StringView text{};
+        Vector<size_t> ends{};  // pozycja końca (znaku kończącego) każdego pola
+        Vector<size_t> rows{};  // indeks pierwszego pola każdego wiersza (+ indeks za ostatnim polem)
+
+        /// Liczba wierszy.
+        [[nodiscard]] size_t row_count() const noexcept {
+            return rows.empty() ? 0 : rows.size() - 1;
+        }
+        /// Liczba pól we wszystkich wierszach.
+        [[nodiscard]] size_t field_count() const noexcept {
+            return ends.size();
+        }
+        /// Pole o wskazanym numerze (numeracja ciągła przez wszystkie wiersze).
+        [[nodiscard]] StringView field(size_t const i) const noexcept {
+            auto const begin = (i == 0) ? 0 : ends[i - 1] + 1;
+            return text.substr(begin, ends[i] - begin);
+        }
+        /// Pole 'column' w wierszu 'row'.
+        [[nodiscard]] StringView field(size_t const row, size_t const column) const noexcept {
+            return field(rows[row] + column);
+        }
+        /// Liczba pól w wierszu 'row'.
+        [[nodiscard]] size_t row_size(size_t const row) const noexcept {
+            return rows[row + 1] - rows[row];
+        }
+    };
+
+    /// Tokenizacja całego bufora w jednym przebiegu (znaki 'delimiter' i '\n'
+    /// wyszukiwane są po 16 (SSE2) lub 64 (AVX2) bajty naraz; wariant wybierany w trakcie działania).
+    /// Pusty tekst nie zawiera wierszy, końcowy '\n' nie tworzy pustego wiersza.
+    /// \param text Tekst do podziału (musi żyć dłużej niż wynik),
+    /// \param delimiter Znak rozdzielający pola w wierszu.
+    /// \return Granice pól i wierszy.
+    Tokens tokenize_lines(StringView text, char delimiter = ',') noexcept;
+
+    /// Tokenizacja do istniejącego wyniku (bufory są używane ponownie, bez alokacji).
+    void tokenize_lines(StringView text, char delimiter, Tokens& tokens) noexcept;
+
+    /// Liczba wystąpień znaku w tekście (wariant SSE2/AVX2 wybierany w trakcie działania).
+    size_t count_char(StringView text, char c) noexcept;
+
+    /// Pozycja pierwszego znaku, który nie jest białym znakiem ASCII (lub text.size()).
+    /// Białe znaki sprawdzane są po 16 naraz (SSE2).
+    size_t skip_spaces(StringView text) noexcept;
+
+    /// Długość tekstu po odrzuceniu końcowych białych znaków ASCII (0, gdy są tylko białe znaki).
+    size_t skip_spaces_back(StringView text) noexcept;
+}
@@ -38,6 +38,7 @@
 #include <expected>
 #include <unordered_set>
 #include <unordered_map>
+#include <concepts>
 
 template<typename T>
 concept Stringable =
@@ -105,4 +106,8 @@ namespace bee {
     template<typename T, typename U> using Pair = std::pair<T, U>;
     template<typename... T> using Variant = std::variant<T...>;
 
+    /// Typy liczbowe (liczby całkowite i zmiennoprzecinkowe, bez bool).
+    template<typename T>
+    concept Scalar = (std::integral<T> || std::floating_point<T>) && !std::same_as<T, bool>;
+
 }